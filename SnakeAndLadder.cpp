@@ -1,9 +1,34 @@
 #include <iostream>
 #include <vector>
-#include <map>
+#include <array>
 #include <deque>
 #include <cstdlib>
+#include <cstring>
+#include <cctype>
 #include <ctime>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <charconv>
+#include <new>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#if defined(__unix__) || defined(__APPLE__)
+#define HAS_POSIX_MAPPING 1
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <functional>
+#include <chrono>
 
 using namespace std;
 
@@ -22,20 +47,392 @@ public:
     }
 };
 
+// Small, fast, seedable generator for simulations and board generation (xoshiro256**)
+class FastRandom {
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    FastRandom(uint64_t seed) {
+        // SplitMix64 expands the seed into the full state
+        for(int i = 0; i < 4; i++) {
+            seed += 0x9E3779B97F4A7C15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            state[i] = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform value in [0, bound)
+    uint32_t nextBelow(uint32_t bound) {
+        return (uint32_t)(((next() >> 32) * bound) >> 32);
+    }
+};
+
+// Eight interleaved xoshiro256** streams stored lane by lane, so each step is plain
+// element-wise arithmetic the compiler can keep in vector registers (no intrinsics needed)
+class BatchRandom {
+public:
+    static const int lanes = 8;
+    static const int rollsPerBlock = 256;
+
+private:
+    uint64_t s0[lanes], s1[lanes], s2[lanes], s3[lanes];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    BatchRandom(uint64_t seed) {
+        // Lanes come from one FastRandom so they are distinct streams for every seed
+        FastRandom seeder(seed);
+        for(int i = 0; i < lanes; i++) {
+            s0[i] = seeder.next();
+            s1[i] = seeder.next();
+            s2[i] = seeder.next();
+            s3[i] = seeder.next();
+        }
+    }
+
+    // steps * lanes outputs. The state is worked on in locals so the compiler
+    // knows out cannot alias it, which is what lets the lane loop vectorize.
+    void fill(uint64_t* out, size_t steps) {
+        uint64_t a[lanes], b[lanes], c[lanes], d[lanes];
+        memcpy(a, s0, sizeof(a));
+        memcpy(b, s1, sizeof(b));
+        memcpy(c, s2, sizeof(c));
+        memcpy(d, s3, sizeof(d));
+
+        for(size_t step = 0; step < steps; step++) {
+            uint64_t result[lanes];
+            for(int i = 0; i < lanes; i++) {
+                result[i] = rotl(b[i] * 5, 7) * 9;
+                uint64_t t = b[i] << 17;
+                c[i] ^= a[i];
+                d[i] ^= b[i];
+                b[i] ^= c[i];
+                a[i] ^= d[i];
+                c[i] ^= t;
+                d[i] = rotl(d[i], 45);
+            }
+            memcpy(out + step * lanes, result, sizeof(result));
+        }
+
+        memcpy(s0, a, sizeof(a));
+        memcpy(s1, b, sizeof(b));
+        memcpy(s2, c, sizeof(c));
+        memcpy(s3, d, sizeof(d));
+    }
+
+    // count values uniform in [1, faces] (faces <= 255). Lemire's multiply-shift on each
+    // 16-bit slice gives four rolls per 64-bit output; the rare biased products are
+    // redrawn afterwards so the result is exact.
+    void rollBatch(uint8_t* out, size_t count, uint32_t faces) {
+        const uint16_t faces16 = (uint16_t)faces;
+        const uint16_t rejectBelow = (uint16_t)((65536u - faces) % faces);
+        uint64_t words[rollsPerBlock / 4];
+        uint16_t slices[rollsPerBlock];
+        uint8_t block[rollsPerBlock];
+
+        size_t done = 0;
+        while(done < count) {
+            fill(words, rollsPerBlock / 4 / lanes);
+            memcpy(slices, words, sizeof(slices));
+
+            // The 24-bit product slice * faces is built from two byte-sized halves so every
+            // step stays in 16-bit lanes (x86 has no packed 16x16 -> 32 multiply before AVX-512)
+            uint16_t rejected = 0;
+            for(int i = 0; i < rollsPerBlock; i++) {
+                uint16_t x = slices[i];
+                uint16_t high = (uint16_t)((x >> 8) * faces16);
+                uint16_t low = (uint16_t)((x & 0xFF) * faces16);
+                uint16_t top = (uint16_t)(high + (low >> 8));  // product >> 8
+                uint16_t fraction = (uint16_t)((top << 8) | (low & 0xFF));
+                block[i] = (uint8_t)((top >> 8) + 1);
+                rejected |= (uint16_t)(fraction < rejectBelow);
+            }
+            if(rejected) {
+                for(int i = 0; i < rollsPerBlock; i++) {
+                    uint32_t m = (uint32_t)slices[i] * faces;
+                    while((uint16_t)m < rejectBelow) {
+                        uint64_t fresh[lanes];
+                        fill(fresh, 1);
+                        m = (uint32_t)(uint16_t)fresh[0] * faces;
+                    }
+                    block[i] = (uint8_t)((m >> 16) + 1);
+                }
+            }
+
+            size_t take = min(count - done, (size_t)rollsPerBlock);
+            memcpy(out + done, block, take);
+            done += take;
+        }
+    }
+};
+
+// Probability of every roll value 1..maxValue, sampled in O(1) with Walker's alias method.
+// Built from face weights (loaded dice) or combined from several dice (sums, keep highest).
+class DiceDistribution {
+private:
+    vector<double> probabilities;  // index value - 1
+    vector<uint64_t> threshold;    // keep the column when the low 32 random bits fall below this
+    vector<uint32_t> alias;
+    bool uniform;
+
+    void buildAliasTable() {
+        size_t n = probabilities.size();
+        threshold.assign(n, 1ULL << 32);
+        alias.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            alias[i] = (uint32_t)i;
+        }
+
+        // Vose: pair each under-full column with an over-full one
+        vector<double> scaled(n);
+        vector<uint32_t> small, large;
+        for(size_t i = 0; i < n; i++) {
+            scaled[i] = probabilities[i] * n;
+            if(scaled[i] < 1.0) small.push_back((uint32_t)i);
+            else large.push_back((uint32_t)i);
+        }
+        while(!small.empty() && !large.empty()) {
+            uint32_t low = small.back();
+            small.pop_back();
+            uint32_t high = large.back();
+
+            threshold[low] = (uint64_t)(scaled[low] * 4294967296.0);
+            alias[low] = high;
+            scaled[high] -= 1.0 - scaled[low];
+            if(scaled[high] < 1.0) {
+                large.pop_back();
+                small.push_back(high);
+            }
+        }
+        // Leftovers are full columns up to rounding
+    }
+
+public:
+    // weights[i] is the relative weight of rolling i + 1
+    DiceDistribution(vector<double> weights) {
+        double total = 0.0;
+        bool valid = !weights.empty();
+        for(double w : weights) {
+            if(!(w >= 0.0)) valid = false;
+            total += w;
+        }
+        if(!valid || total <= 0.0) {
+            cout << "Invalid dice weights. Falling back to a fair die." << endl;
+            weights.assign(max<size_t>(weights.size(), 1), 1.0);
+            total = (double)weights.size();
+        }
+
+        probabilities.resize(weights.size());
+        uniform = true;
+        for(size_t i = 0; i < weights.size(); i++) {
+            probabilities[i] = weights[i] / total;
+            if(weights[i] != weights[0]) uniform = false;
+        }
+        buildAliasTable();
+    }
+
+    static DiceDistribution fair(int faces) {
+        return DiceDistribution(vector<double>(max(faces, 1), 1.0));
+    }
+
+    // Distribution of the sum of two independent rolls
+    static DiceDistribution convolve(const DiceDistribution& a, const DiceDistribution& b) {
+        vector<double> weights(a.probabilities.size() + b.probabilities.size(), 0.0);
+        for(size_t i = 0; i < a.probabilities.size(); i++) {
+            for(size_t j = 0; j < b.probabilities.size(); j++) {
+                // values (i + 1) + (j + 1) sit at index i + j + 1
+                weights[i + j + 1] += a.probabilities[i] * b.probabilities[j];
+            }
+        }
+        return DiceDistribution(weights);
+    }
+
+    // Sum of count fair dice, e.g. sumOf(2, 6) for 2d6
+    static DiceDistribution sumOf(int count, int faces) {
+        DiceDistribution result = fair(faces);
+        for(int i = 1; i < count; i++) {
+            result = convolve(result, fair(faces));
+        }
+        return result;
+    }
+
+    // Roll count fair dice and keep the highest ("roll two, pick one")
+    static DiceDistribution keepHighest(int count, int faces) {
+        faces = max(faces, 1);
+        vector<double> weights(faces);
+        for(int value = 1; value <= faces; value++) {
+            weights[value - 1] = pow((double)value / faces, count) - pow((double)(value - 1) / faces, count);
+        }
+        return DiceDistribution(weights);
+    }
+
+    int getMaxValue() const {
+        return (int)probabilities.size();
+    }
+
+    double probability(int value) const {
+        if(value < 1 || value > (int)probabilities.size()) return 0.0;
+        return probabilities[value - 1];
+    }
+
+    bool isUniform() const {
+        return uniform;
+    }
+
+    int sample(FastRandom& rng) const {
+        return sampleFrom(rng.next());
+    }
+
+    // One 64-bit draw: high half picks the column, low half the coin
+    int sampleFrom(uint64_t r) const {
+        uint32_t column = (uint32_t)(((r >> 32) * probabilities.size()) >> 32);
+        // Branch-free select: a mispredicted coin flip costs more than the rest of the sample
+        uint32_t keep = 0u - (uint32_t)((r & 0xFFFFFFFFULL) < threshold[column]);
+        uint32_t value = alias[column] ^ ((column ^ alias[column]) & keep);
+        return (int)value + 1;
+    }
+
+    // Cache key: the face count for a fair die, otherwise a hash of the probabilities
+    uint64_t getKey() const {
+        if(uniform) {
+            return probabilities.size();
+        }
+        uint64_t h = 0xD1CE0000ULL ^ probabilities.size();
+        for(double p : probabilities) {
+            uint64_t bits;
+            memcpy(&bits, &p, sizeof(bits));
+            h = (h ^ bits) * 0x100000001B3ULL;
+            h ^= h >> 29;
+        }
+        return h | (1ULL << 63);
+    }
+};
+
 // Dice class
 class Dice {
 private:
     int faceCount;
+    DiceDistribution distribution;
+    FastRandom weightedRng;  // only used for non-uniform distributions
+    BatchRandom batchRng;
     
 public:
-    Dice(int f) {
+    Dice(int f) : distribution(DiceDistribution::fair(f)), weightedRng(time(0)), batchRng(time(0) ^ 0xBA7C4ULL) {
         faceCount = f;
         srand(time(0));
     }
+
+    Dice(const DiceDistribution& d) : distribution(d), weightedRng(time(0)), batchRng(time(0) ^ 0xBA7C4ULL) {
+        faceCount = d.getMaxValue();
+        srand(time(0));
+    }
     
     int roll() {
+        if(!distribution.isUniform()) {
+            return distribution.sample(weightedRng);
+        }
         return (rand() % faceCount) + 1;
     }
+
+    // Fills out with count rolls in one go; roll values must fit in a byte
+    bool rollBatch(uint8_t* out, size_t count) {
+        if(faceCount > 255) {
+            cout << "Batch rolls support at most 255 faces." << endl;
+            return false;
+        }
+        if(distribution.isUniform()) {
+            batchRng.rollBatch(out, count, faceCount);
+            return true;
+        }
+
+        uint64_t words[BatchRandom::lanes];
+        for(size_t done = 0; done < count; done += BatchRandom::lanes) {
+            batchRng.fill(words, 1);
+            size_t take = min(count - done, (size_t)BatchRandom::lanes);
+            for(size_t i = 0; i < take; i++) {
+                out[done + i] = (uint8_t)distribution.sampleFrom(words[i]);
+            }
+        }
+        return true;
+    }
+
+    int getFaceCount() {
+        return faceCount;
+    }
+
+    const DiceDistribution& getDistribution() {
+        return distribution;
+    }
+};
+
+// Refillable block of pre-generated rolls. Each simulation thread owns one, so the
+// per-roll cost is a byte load and the generator runs in bulk off the critical path.
+class RollBuffer {
+private:
+    DiceDistribution distribution;
+    BatchRandom rng;
+    vector<uint8_t> rolls;
+    const uint8_t* cursor;
+    const uint8_t* end;
+
+    void refill() {
+        if(distribution.isUniform()) {
+            rng.rollBatch(rolls.data(), rolls.size(), distribution.getMaxValue());
+        }
+        else {
+            vector<uint64_t> words(rolls.size());
+            rng.fill(words.data(), rolls.size() / BatchRandom::lanes);
+            for(size_t i = 0; i < rolls.size(); i++) {
+                rolls[i] = (uint8_t)distribution.sampleFrom(words[i]);
+            }
+        }
+        cursor = rolls.data();
+    }
+
+public:
+    static const size_t blockSize = 4096;  // multiple of the generator's lane count
+
+    RollBuffer(const DiceDistribution& d, uint64_t seed) : distribution(d), rng(seed), rolls(blockSize) {
+        if(d.getMaxValue() > 255) {
+            cout << "Roll buffers support at most 255 faces. Using a fair 6-faced die." << endl;
+            distribution = DiceDistribution::fair(6);
+        }
+        end = rolls.data() + rolls.size();
+        cursor = end;
+    }
+
+    // Copying would leave the cursors pointing into the source's buffer
+    RollBuffer(const RollBuffer&) = delete;
+    RollBuffer& operator=(const RollBuffer&) = delete;
+
+    int next() {
+        if(cursor == end) {
+            refill();
+        }
+        return *cursor++;
+    }
 };
 
 // Base class for Snake and Ladder (both have start and end positions)
@@ -101,41 +498,478 @@ public:
 
 class BoardSetupStrategy;
 
+// Plain (start, end, kind) record used for bulk entity loading
+struct BoardEntityRecord {
+    int start;
+    int end;
+    bool isSnake;
+};
+
+// Start-cell -> entity rank lookup, rebuilt from the sorted entity starts.
+// The representation is picked from the cell count and entity density:
+//   DENSE       - one int per cell; best for ordinary boards that fit in cache
+//   BITMAP_RANK - one bit per cell plus a rank counter per 64-bit word (~1.5 bits/cell); dense-ish huge boards
+//   EYTZINGER   - starts in BFS order for a prefetch-friendly search; very sparse huge boards
+class EntityLookup {
+public:
+    enum Mode {
+        AUTO,
+        DENSE,
+        BITMAP_RANK,
+        EYTZINGER
+    };
+    
+private:
+    Mode mode;
+    int cellCount;
+    vector<int> denseRanks;          // DENSE: rank per cell, -1 if empty
+    vector<uint64_t> bitmapWords;    // BITMAP_RANK: start bits
+    vector<uint32_t> wordRankBase;   // BITMAP_RANK: entities before each word
+    vector<int> eytzingerKeys;       // EYTZINGER: 1-based BFS layout of the starts
+    vector<int> eytzingerRanks;
+    
+    static int popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        int count = 0;
+        for(; x != 0; x &= x - 1) count++;
+        return count;
+#endif
+    }
+    
+    // Fills the BFS layout with an in-order walk of the implicit tree
+    void fillEytzinger(const vector<int>& starts, size_t& next, size_t node) {
+        if(node >= eytzingerKeys.size()) return;
+        fillEytzinger(starts, next, 2 * node);
+        eytzingerKeys[node] = starts[next];
+        eytzingerRanks[node] = (int)next;
+        next++;
+        fillEytzinger(starts, next, 2 * node + 1);
+    }
+    
+public:
+    EntityLookup() {
+        mode = DENSE;
+        cellCount = 0;
+    }
+    
+    // Crossovers from --bench-index: the dense table only wins while it stays in cache (~1 MB), and
+    // bitmap-rank is faster than the search at every density, so the search is only chosen when the
+    // bitmap would be more than 8x larger than the sorted starts (density below ~0.3%)
+    static Mode chooseMode(int cells, size_t entities) {
+        if(cells <= (1 << 18)) return DENSE;
+        double bitmapBytes = cells * (1.5 / 8.0);
+        double searchBytes = entities * 8.0;
+        return bitmapBytes > 8.0 * searchBytes ? EYTZINGER : BITMAP_RANK;
+    }
+    
+    void build(int cells, const vector<int>& sortedStarts, Mode requested = AUTO) {
+        cellCount = cells;
+        mode = requested == AUTO ? chooseMode(cells, sortedStarts.size()) : requested;
+        vector<int>().swap(denseRanks);
+        vector<uint64_t>().swap(bitmapWords);
+        vector<uint32_t>().swap(wordRankBase);
+        vector<int>().swap(eytzingerKeys);
+        vector<int>().swap(eytzingerRanks);
+        
+        if(mode == DENSE) {
+            denseRanks.assign(cells + 1, -1);
+            for(size_t i = 0; i < sortedStarts.size(); i++) {
+                denseRanks[sortedStarts[i]] = (int)i;
+            }
+        }
+        else if(mode == BITMAP_RANK) {
+            size_t words = (size_t)cells / 64 + 1;
+            bitmapWords.assign(words, 0);
+            wordRankBase.assign(words, 0);
+            for(int start : sortedStarts) {
+                bitmapWords[start >> 6] |= 1ULL << (start & 63);
+            }
+            uint32_t running = 0;
+            for(size_t w = 0; w < words; w++) {
+                wordRankBase[w] = running;
+                running += popcount64(bitmapWords[w]);
+            }
+        }
+        else {
+            eytzingerKeys.assign(sortedStarts.size() + 1, 0);
+            eytzingerRanks.assign(sortedStarts.size() + 1, -1);
+            size_t next = 0;
+            fillEytzinger(sortedStarts, next, 1);
+        }
+    }
+    
+    // Rank of the entity starting at position, or -1
+    inline int find(int position) const {
+        if(position < 0 || position > cellCount) return -1;
+        
+        if(mode == DENSE) {
+            return denseRanks[position];
+        }
+        if(mode == BITMAP_RANK) {
+            uint64_t word = bitmapWords[position >> 6];
+            uint64_t bit = 1ULL << (position & 63);
+            if((word & bit) == 0) return -1;
+            return (int)(wordRankBase[position >> 6] + popcount64(word & (bit - 1)));
+        }
+        
+        size_t n = eytzingerKeys.size() - 1;
+        size_t k = 1;
+        while(k <= n) {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(eytzingerKeys.data() + min(k * 16, n));  // four levels ahead, kept inside the array
+#endif
+            k = 2 * k + (eytzingerKeys[k] < position);
+        }
+        // Undo the trailing right turns to land on the lower bound
+        while(k & 1) k >>= 1;
+        k >>= 1;
+        if(k == 0 || eytzingerKeys[k] != position) return -1;
+        return eytzingerRanks[k];
+    }
+    
+    // In-place update for one start added at `rank` or removed from it, so single edits do not
+    // rebuild the table. DENSE then needs shiftRank() for each later start, whose rank moved by
+    // one; BITMAP_RANK fixes its per-word counts here. EYTZINGER cannot be patched and returns
+    // false, and must be rebuilt.
+    bool patchStart(int position, int rank, bool added) {
+        if(mode == DENSE) {
+            denseRanks[position] = added ? rank : -1;
+            return true;
+        }
+        if(mode == BITMAP_RANK) {
+            uint64_t bit = 1ULL << (position & 63);
+            if(added) bitmapWords[position >> 6] |= bit;
+            else bitmapWords[position >> 6] &= ~bit;
+            for(size_t w = (size_t)(position >> 6) + 1; w < wordRankBase.size(); w++) {
+                if(added) wordRankBase[w]++;
+                else wordRankBase[w]--;
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void shiftRank(int position, int delta) {
+        if(mode == DENSE) {
+            denseRanks[position] += delta;
+        }
+    }
+
+    Mode getMode() const {
+        return mode;
+    }
+};
+
 // Board class
 class Board {
 private:
     int cellCount; // total cells on the board (size*size)
     vector<BoardEntity*> entitiesList;
-    map<int, BoardEntity*> entityMap;
+    vector<pair<int, BoardEntity*>> entityIndex; // sorted by start position
+    vector<BoardEntity*> heapEntities;           // added one at a time with new
+    vector<pair<char*, size_t>> entityBlocks;    // bulk-loaded entities, constructed in place
+    vector<char*> freeSlots;                     // block slots whose entity was removed, reused first
+    EntityLookup lookup;                         // read-side index over entityIndex
+    bool lookupDirty = true;
+    vector<int> chainEnds;                       // final destination per entity rank when chains are followed
+    bool chainsDirty = true;
+    bool chainsAcyclic = true;
+    
+    static size_t entitySlotSize() {
+        return max(sizeof(Snake), sizeof(Ladder));
+    }
+    
+    vector<pair<int, BoardEntity*>>::iterator findEntry(int position) {
+        return lower_bound(entityIndex.begin(), entityIndex.end(), position,
+            [](const pair<int, BoardEntity*>& entry, int pos) { return entry.first < pos; });
+    }
+    
+    // Keeps a built lookup current after entityIndex[index] was inserted (added) or erased; only
+    // a lookup that cannot be patched is left for a rebuild
+    void patchLookup(size_t index, int position, bool added) {
+        chainsDirty = true;
+        if(lookupDirty) return;
+        if(!lookup.patchStart(position, (int)index, added)) {
+            lookupDirty = true;
+            return;
+        }
+        if(lookup.getMode() == EntityLookup::DENSE) {
+            for(size_t i = added ? index + 1 : index; i < entityIndex.size(); i++) {
+                lookup.shiftRank(entityIndex[i].first, added ? 1 : -1);
+            }
+        }
+    }
+    
+    // LSD radix sort on the start index (11-bit digits); std::sort for small inputs
+    static void sortByStart(vector<BoardEntityRecord>& records) {
+        if(records.size() < 4096) {
+            sort(records.begin(), records.end(),
+                [](const BoardEntityRecord& a, const BoardEntityRecord& b) { return a.start < b.start; });
+            return;
+        }
+        
+        vector<BoardEntityRecord> buffer(records.size());
+        for(int shift = 0; shift < 32; shift += 11) {
+            size_t counts[2048] = {0};
+            for(auto& record : records) {
+                counts[((uint32_t)record.start >> shift) & 2047]++;
+            }
+            if(counts[((uint32_t)records[0].start >> shift) & 2047] == records.size()) continue; // digit is constant
+            
+            size_t offset = 0;
+            for(auto& count : counts) {
+                size_t c = count;
+                count = offset;
+                offset += c;
+            }
+            for(auto& record : records) {
+                buffer[counts[((uint32_t)record.start >> shift) & 2047]++] = record;
+            }
+            records.swap(buffer);
+        }
+    }
     
 public:
     Board(int s) {
+        if(s < 0 || s > 46340) {
+            cout << "Board size " << s << " is out of range; use HugeBoard for boards beyond 2^31 cells." << endl;
+            s = 0;
+        }
         cellCount = s * s;  // m*m board
     }
     
     bool canAddEntity(int position) {
-        return entityMap.find(position) == entityMap.end();
+        auto it = findEntry(position);
+        return it == entityIndex.end() || it->first != position;
     }
     
+    // Single sorted insert, O(entities); anything adding more than a few should use addBoardEntities
     void addBoardEntity(BoardEntity* boardEntity) {
-        if(canAddEntity(boardEntity->getStart())) {
+        auto it = findEntry(boardEntity->getStart());
+        if(it == entityIndex.end() || it->first != boardEntity->getStart()) {
             entitiesList.push_back(boardEntity);
-            entityMap[boardEntity->getStart()] = boardEntity;
+            heapEntities.push_back(boardEntity);
+            size_t index = it - entityIndex.begin();
+            entityIndex.insert(it, make_pair(boardEntity->getStart(), boardEntity));
+            patchLookup(index, boardEntity->getStart(), true);
+        }
+    }
+    
+    // Removes the entity starting at position. Heap entities are deleted; bulk-loaded ones are
+    // destroyed and their slot is handed to the next bulk insert.
+    bool removeBoardEntity(int position) {
+        auto it = findEntry(position);
+        if(it == entityIndex.end() || it->first != position) {
+            return false;
+        }
+        BoardEntity* entity = it->second;
+        size_t index = it - entityIndex.begin();
+        entityIndex.erase(it);
+        entitiesList.erase(find(entitiesList.begin(), entitiesList.end(), entity));
+        
+        auto owned = find(heapEntities.begin(), heapEntities.end(), entity);
+        if(owned != heapEntities.end()) {
+            heapEntities.erase(owned);
+            delete entity;
+        }
+        else {
+            entity->~BoardEntity();
+            freeSlots.push_back((char*)entity);
+        }
+        patchLookup(index, position, false);
+        return true;
+    }
+    
+    // Bulk path: sorts the records, validates them in one pass and builds the index by merging.
+    // Nothing is inserted if any record is invalid or collides with an existing entity.
+    bool addBoardEntities(vector<BoardEntityRecord> records) {
+        if(records.empty()) return true;
+        
+        bool sorted = true;
+        for(size_t i = 1; i < records.size() && sorted; i++) {
+            sorted = records[i - 1].start <= records[i].start;
+        }
+        if(!sorted) {
+            sortByStart(records);
+        }
+        
+        // Single pass over the sorted records, walking the existing index alongside
+        auto existing = entityIndex.begin();
+        for(size_t i = 0; i < records.size(); i++) {
+            BoardEntityRecord& record = records[i];
+            bool validGeometry = record.start >= 1 && record.start < cellCount && record.end >= 1 && record.end <= cellCount
+                && (record.isSnake ? record.end < record.start : record.end > record.start);
+            if(!validGeometry) {
+                cout << "Invalid " << (record.isSnake ? "snake" : "ladder") << " " << record.start << " -> " << record.end << "." << endl;
+                return false;
+            }
+            
+            while(existing != entityIndex.end() && existing->first < record.start) existing++;
+            if((i > 0 && records[i - 1].start == record.start) || (existing != entityIndex.end() && existing->first == record.start)) {
+                cout << "Duplicate entity start at cell " << record.start << "." << endl;
+                return false;
+            }
+        }
+        
+        // Slots left by removed entities first, then one allocation for the rest of the batch, so
+        // add/remove cycles (IncrementalAnalyzer edits) run in constant memory
+        size_t reused = min(freeSlots.size(), records.size());
+        size_t fresh = records.size() - reused;
+        char* block = nullptr;
+        if(fresh > 0) {
+            block = (char*)::operator new(fresh * entitySlotSize());
+            entityBlocks.push_back(make_pair(block, fresh));
+        }
+        
+        vector<pair<int, BoardEntity*>> added;
+        added.reserve(records.size());
+        entitiesList.reserve(entitiesList.size() + records.size());
+        for(size_t i = 0; i < records.size(); i++) {
+            BoardEntityRecord& record = records[i];
+            char* slot = i < reused ? freeSlots[freeSlots.size() - 1 - i] : block + (i - reused) * entitySlotSize();
+            BoardEntity* entity;
+            if(record.isSnake) {
+                entity = new (slot) Snake(record.start, record.end);
+            }
+            else {
+                entity = new (slot) Ladder(record.start, record.end);
+            }
+            entitiesList.push_back(entity);
+            added.push_back(make_pair(record.start, entity));
+        }
+        freeSlots.resize(freeSlots.size() - reused);
+        
+        if(entityIndex.empty()) {
+            entityIndex.swap(added);
+        }
+        else {
+            vector<pair<int, BoardEntity*>> merged;
+            merged.reserve(entityIndex.size() + added.size());
+            merge(entityIndex.begin(), entityIndex.end(), added.begin(), added.end(), back_inserter(merged),
+                [](const pair<int, BoardEntity*>& a, const pair<int, BoardEntity*>& b) { return a.first < b.first; });
+            entityIndex.swap(merged);
+        }
+        // A single record (an IncrementalAnalyzer edit) is patched into the lookup; batches rebuild it
+        if(records.size() == 1) {
+            patchLookup(findEntry(records[0].start) - entityIndex.begin(), records[0].start, true);
+        }
+        else {
+            lookupDirty = true;
+        }
+        return true;
+    }
+    
+    // Rebuilds the lookup structure; done after setup and lazily after any later change
+    void buildLookup(EntityLookup::Mode mode = EntityLookup::AUTO) {
+        vector<int> starts(entityIndex.size());
+        for(size_t i = 0; i < entityIndex.size(); i++) {
+            starts[i] = entityIndex[i].first;
+        }
+        lookup.build(cellCount, starts, mode);
+        lookupDirty = false;
+        chainsDirty = true;
+    }
+    
+    // Computes the transitive final destination of every entity in O(n) with path compression.
+    // Entities on a cycle are reported and keep their single-hop destination; returns false if any exist.
+    bool resolveChains() {
+        if(lookupDirty) {
+            buildLookup();
+        }
+        if(!chainsDirty) {
+            return chainsAcyclic;
+        }
+        
+        size_t count = entityIndex.size();
+        vector<char> state(count, 0);  // 0 = unvisited, 1 = on the current path, 2 = resolved
+        chainEnds.assign(count, 0);
+        vector<int> path;
+        bool acyclic = true;
+        
+        for(size_t first = 0; first < count; first++) {
+            if(state[first] == 2) continue;
+            
+            path.clear();
+            int rank = (int)first;
+            int finalCell = 0;
+            bool cycle = false;
+            while(true) {
+                if(state[rank] == 2) {
+                    finalCell = chainEnds[rank];
+                    break;
+                }
+                if(state[rank] == 1) {
+                    cycle = true;
+                    break;
+                }
+                state[rank] = 1;
+                path.push_back(rank);
+                
+                int end = entityIndex[rank].second->getEnd();
+                int nextRank = lookup.find(end);
+                if(nextRank < 0) {
+                    finalCell = end;
+                    break;
+                }
+                rank = nextRank;
+            }
+            
+            if(cycle) {
+                // The path may lead into the cycle from outside; report only the loop itself
+                acyclic = false;
+                cout << "Cycle in snake/ladder chain:";
+                for(size_t i = find(path.begin(), path.end(), rank) - path.begin(); i < path.size(); i++) {
+                    cout << " " << entityIndex[path[i]].first;
+                }
+                cout << endl;
+            }
+            for(int r : path) {
+                chainEnds[r] = cycle ? entityIndex[r].second->getEnd() : finalCell;
+                state[r] = 2;
+            }
+        }
+        
+        chainsDirty = false;
+        chainsAcyclic = acyclic;
+        return acyclic;
+    }
+    
+    // Where a player landing on position ends up once chains are followed; O(1) after resolveChains()
+    int getChainedDestination(int position) {
+        if(lookupDirty || chainsDirty) {
+            resolveChains();
         }
+        int rank = lookup.find(position);
+        return rank < 0 ? position : chainEnds[rank];
+    }
+    
+    EntityLookup::Mode getLookupMode() {
+        return lookup.getMode();
     }
     
     void setupBoard(BoardSetupStrategy* strategy);
     
     BoardEntity* getEntity(int position) {
-        if(entityMap.find(position) != entityMap.end()) {
-            return entityMap[position];
+        if(lookupDirty) {
+            buildLookup();
         }
-        return nullptr;
+        int rank = lookup.find(position);
+        return rank < 0 ? nullptr : entityIndex[rank].second;
     }
     
-    int getBoardSize() { 
+    int getBoardSize() const { 
         return cellCount;
     }
+
+    vector<BoardEntity*>& getEntities() {
+        return entitiesList;
+    }
+
+    const vector<BoardEntity*>& getEntities() const {
+        return entitiesList;
+    }
     
     void display() {
         cout << "\n=== Board Configuration ===" << endl;
@@ -163,17 +997,323 @@ public:
         }
         cout << "=========================" << endl;
     }
+
+    // Per-cell values (indexed by cell) drawn as shades on the board grid, top row first in the
+    // usual zigzag order. Snake heads are marked S and ladder feet L.
+    void displayHeatmap(const vector<double>& perCell, string title) {
+        static const char shades[] = " .:-=+*#%@";
+        int side = (int)lround(sqrt((double)cellCount));
+        double highest = 0.0;
+        for(int cell = 1; cell <= cellCount && cell < (int)perCell.size(); cell++) {
+            highest = max(highest, perCell[cell]);
+        }
+
+        cout << "\n=== " << title << " ===" << endl;
+        for(int row = side - 1; row >= 0; row--) {
+            string line;
+            for(int column = 0; column < side; column++) {
+                int cell = row * side + (row % 2 == 0 ? column : side - 1 - column) + 1;
+                double value = cell < (int)perCell.size() ? perCell[cell] : 0.0;
+                int level = highest > 0.0 ? (int)lround(value / highest * 9) : 0;
+                BoardEntity* entity = getEntity(cell);
+                line += shades[min(9, max(0, level))];
+                line += entity == nullptr ? ' ' : (entity->getEnd() < cell ? 'S' : 'L');
+                line += ' ';
+            }
+            cout << line << endl;
+        }
+        cout << "Scale: ' ' = 0 ... '@' = " << highest << endl;
+    }
     
     ~Board() {
-        for(auto entity : entitiesList) {
+        for(auto entity : heapEntities) {
             delete entity;
         }
+        // Free slots hold no entity any more
+        sort(freeSlots.begin(), freeSlots.end(), less<char*>());
+        for(auto& block : entityBlocks) {
+            for(size_t i = 0; i < block.second; i++) {
+                char* slot = block.first + i * entitySlotSize();
+                if(!binary_search(freeSlots.begin(), freeSlots.end(), slot, less<char*>())) {
+                    ((BoardEntity*)slot)->~BoardEntity();
+                }
+            }
+            ::operator delete(block.first);
+        }
     }
 };
 
 
-// Strategy Pattern for Board Setup
-class BoardSetupStrategy {
+// Fenwick tree over free start cells: uniform sampling of a free cell in a range in O(log n)
+class FreeCellSampler {
+private:
+    int cellCount;
+    int highestPower;
+    vector<int> tree;  // 1-based Fenwick tree of free flags
+    FastRandom* rng;   // null: draw from rand()
+
+    int prefixFree(int cell) {
+        int total = 0;
+        for(int i = min(cell, cellCount); i > 0; i -= i & -i) {
+            total += tree[i];
+        }
+        return total;
+    }
+
+    // Smallest cell whose prefix count of free cells reaches rank (1-based)
+    int selectFree(int rank) {
+        int position = 0;
+        for(int step = highestPower; step > 0; step >>= 1) {
+            if(position + step <= cellCount && tree[position + step] < rank) {
+                position += step;
+                rank -= tree[position];
+            }
+        }
+        return position + 1;
+    }
+
+public:
+    FreeCellSampler(int cells, const vector<bool>& occupied, FastRandom* random = nullptr) {
+        cellCount = cells;
+        rng = random;
+        highestPower = 1;
+        while(highestPower * 2 <= cellCount) highestPower *= 2;
+
+        // Linear-time Fenwick construction
+        tree.assign(cellCount + 1, 0);
+        for(int i = 1; i <= cellCount; i++) {
+            tree[i] += occupied[i] ? 0 : 1;
+            int parent = i + (i & -i);
+            if(parent <= cellCount) tree[parent] += tree[i];
+        }
+    }
+
+    int countFree(int low, int high) {
+        if(low > high) return 0;
+        return prefixFree(high) - prefixFree(low - 1);
+    }
+
+    // Caller guarantees countFree(low, high) > 0
+    int sampleFree(int low, int high) {
+        int rank = prefixFree(low - 1) + randomBelow(countFree(low, high)) + 1;
+        return selectFree(rank);
+    }
+
+    void markUsed(int cell) {
+        for(int i = cell; i <= cellCount; i += i & -i) {
+            tree[i]--;
+        }
+    }
+
+    // rand() may only give 15 bits, so two draws are combined for large boards
+    int randomBelow(int bound) {
+        if(rng) return (int)rng->nextBelow((uint32_t)bound);
+        long long value = (long long)rand() * ((long long)RAND_MAX + 1) + rand();
+        return (int)(value % bound);
+    }
+};
+
+// Gaussian elimination with partial pivoting for the small dense systems left over after
+// the sparse part of a board has been eliminated
+class DenseLinearSolver {
+public:
+    // Solves the n x n system in matrix (row major) in place; the answer is left in rhs
+    static bool solve(double* matrix, double* rhs, int n) {
+        for(int col = 0; col < n; col++) {
+            int pivot = col;
+            for(int row = col + 1; row < n; row++) {
+                if(fabs(matrix[row * n + col]) > fabs(matrix[pivot * n + col])) pivot = row;
+            }
+            if(fabs(matrix[pivot * n + col]) < 1e-300) return false;
+            if(pivot != col) {
+                for(int i = 0; i < n; i++) swap(matrix[col * n + i], matrix[pivot * n + i]);
+                swap(rhs[col], rhs[pivot]);
+            }
+            for(int row = col + 1; row < n; row++) {
+                double factor = matrix[row * n + col] / matrix[col * n + col];
+                for(int i = col; i < n; i++) matrix[row * n + i] -= factor * matrix[col * n + i];
+                rhs[row] -= factor * rhs[col];
+            }
+        }
+        for(int row = n - 1; row >= 0; row--) {
+            for(int i = row + 1; i < n; i++) rhs[row] -= matrix[row * n + i] * rhs[i];
+            rhs[row] /= matrix[row * n + row];
+        }
+        return true;
+    }
+};
+
+// Expected-turn band a random board must fall in to count as a given difficulty
+struct DifficultyBand {
+    double low;
+    double high;
+};
+
+struct DifficultyCalibrationRow {
+    int side;
+    DifficultyBand bands[3];  // EASY, MEDIUM, HARD
+};
+
+// Measured difficulty. Each band is centred on the median expected turns (one player, standard
+// rules, fair d6) of boards drawn by that difficulty's snake ratio, +-15%, clipped where it would
+// overlap a neighbouring band. Bands therefore describe the standard game whatever rules a board is
+// later played with. Regenerate the table with --calibrate-difficulty.
+class DifficultyCalibration {
+public:
+    static constexpr int rowCount = 13;
+    static constexpr DifficultyCalibrationRow rows[rowCount] = {
+        {4, {{7.75, 9.19}, {9.19, 9.55}, {9.55, 11.31}}},
+        {5, {{9.63, 11.67}, {11.67, 12.45}, {12.45, 14.84}}},
+        {6, {{12.01, 14.72}, {14.72, 16.22}, {16.22, 19.75}}},
+        {7, {{14.36, 17.89}, {17.89, 20.55}, {20.55, 25.65}}},
+        {8, {{17.05, 21.48}, {21.48, 25.54}, {25.54, 32.61}}},
+        {9, {{19.37, 25.11}, {25.11, 32}, {32, 42.55}}},
+        {10, {{21.99, 29.24}, {29.24, 37.99}, {40.19, 54.37}}},
+        {12, {{27.56, 37.5}, {37.5, 49.86}, {61.53, 83.25}}},
+        {15, {{35.56, 48.11}, {52.93, 71.6}, {96.6, 130.69}}},
+        {20, {{46.92, 63.47}, {77.07, 104.27}, {169.68, 229.57}}},
+        {25, {{57.01, 77.14}, {100.55, 136.03}, {270.74, 366.29}}},
+        {30, {{65.53, 88.65}, {125.37, 169.62}, {369.04, 499.28}}},
+        {40, {{80.31, 108.65}, {172.51, 233.39}, {577.51, 781.34}}},
+    };
+
+    // Band for a board of this many cells, interpolated between calibrated sides;
+    // false outside the calibrated range
+    static bool bandFor(int cells, int difficulty, DifficultyBand& band) {
+        if(difficulty < 0 || difficulty > 2) return false;
+        for(int i = 0; i < rowCount; i++) {
+            int rowCells = rows[i].side * rows[i].side;
+            if(rowCells == cells) {
+                band = rows[i].bands[difficulty];
+                return true;
+            }
+            if(i > 0 && rowCells > cells) {
+                int previousCells = rows[i - 1].side * rows[i - 1].side;
+                if(previousCells > cells) return false;
+                double t = (double)(cells - previousCells) / (rowCells - previousCells);
+                const DifficultyBand& below = rows[i - 1].bands[difficulty];
+                const DifficultyBand& above = rows[i].bands[difficulty];
+                band.low = below.low + t * (above.low - below.low);
+                band.high = below.high + t * (above.high - below.high);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Exact expected turns from the start under the standard rules with a fair d6, and only those:
+    // the exact-roll finish and single-hop entities are built into the sweep, so boards played
+    // with other rules or dice need BoardAnalyzer. Computed without iterating: one sweep down the
+    // board writes every cell's value as an affine function of the (unknown) values at snake
+    // destinations, using a window of the six cells ahead plus the forms kept at ladder
+    // destinations; those unknowns then come from one small dense solve.
+    // O(cells * snakes) time, O((window + destinations) * snakes) memory.
+    static double expectedTurns(int cells, const vector<BoardEntityRecord>& records) {
+        const int faces = 6;
+        vector<int> landing(cells + 1);
+        for(int cell = 0; cell <= cells; cell++) landing[cell] = cell;
+
+        // Unknown slot per distinct snake destination, kept-form slot per distinct ladder destination
+        vector<int> unknownSlot(cells + 1, -1), keptSlot(cells + 1, -1);
+        int unknowns = 0, kept = 0;
+        for(auto& record : records) {
+            landing[record.start] = record.end;
+            if(record.isSnake && unknownSlot[record.end] < 0) unknownSlot[record.end] = unknowns++;
+            if(!record.isSnake && keptSlot[record.end] < 0) keptSlot[record.end] = kept++;
+        }
+
+        // Forms are [constant, coefficient of each unknown]
+        int width = unknowns + 1;
+        vector<double> window(faces * width, 0.0), keptForms(kept * width, 0.0), value(width);
+        vector<double> matrix(unknowns * unknowns, 0.0), rhs(unknowns, 0.0);
+
+        for(int cell = cells; cell >= 0; cell--) {
+            fill(value.begin(), value.end(), 0.0);
+            if(cell < cells) {
+                int validFaces = min(faces, cells - cell);
+                for(int face = 1; face <= validFaces; face++) {
+                    const double* ahead = &window[((cell + face) % faces) * width];
+                    for(int i = 0; i < width; i++) value[i] += ahead[i];
+                }
+                // E = (1 + sum / faces) / (validFaces / faces): rolls past the end stay put
+                value[0] += faces;
+                for(int i = 0; i < width; i++) value[i] /= validFaces;
+            }
+
+            if(unknownSlot[cell] >= 0) {
+                // x_j = value(x)  ->  (I - B) x = a
+                int row = unknownSlot[cell];
+                for(int i = 0; i < unknowns; i++) matrix[row * unknowns + i] = (i == row ? 1.0 : 0.0) - value[i + 1];
+                rhs[row] = value[0];
+            }
+            if(keptSlot[cell] >= 0) {
+                copy(value.begin(), value.end(), keptForms.begin() + keptSlot[cell] * width);
+            }
+
+            // Form of landing on this cell: its own value, a kept ladder form or a snake unknown
+            double* slot = &window[(cell % faces) * width];
+            int destination = landing[cell];
+            if(destination == cell) {
+                copy(value.begin(), value.end(), slot);
+            }
+            else if(destination > cell) {
+                copy(keptForms.begin() + keptSlot[destination] * width, keptForms.begin() + (keptSlot[destination] + 1) * width, slot);
+            }
+            else {
+                fill(slot, slot + width, 0.0);
+                slot[unknownSlot[destination] + 1] = 1.0;
+            }
+        }
+
+        // value now holds the start cell's form
+        if(unknowns > 0 && !DenseLinearSolver::solve(matrix.data(), rhs.data(), unknowns)) return INFINITY;
+        double result = value[0];
+        for(int i = 0; i < unknowns; i++) result += value[i + 1] * rhs[i];
+        return result;
+    }
+};
+
+// Strategy Pattern for Board Setup
+class BoardSetupStrategy {
+protected:
+    // Start cells already taken on the board, for strategies that collect records before a bulk insert
+    static vector<bool> occupiedStarts(Board* board) {
+        vector<bool> occupied(board->getBoardSize() + 1, false);
+        for(auto entity : board->getEntities()) {
+            occupied[entity->getStart()] = true;
+        }
+        return occupied;
+    }
+
+    // Valid start ranges: snakes need room below them, ladders need room above them
+    static int snakeStartLow() { return 10; }
+    static int snakeStartHigh(int cells) { return cells - 1; }
+    static int ladderStartLow() { return 1; }
+    static int ladderStartHigh(int cells) { return cells - 10; }
+
+    // Picks a free start in [low, high] and a uniform end for it; O(log n), no retries
+    static BoardEntityRecord placeEntity(FreeCellSampler& sampler, int cells, int low, int high, bool isSnake) {
+        int startIdx = sampler.sampleFree(low, high);
+        sampler.markUsed(startIdx);
+
+        int endIdx;
+        if(isSnake) {
+            endIdx = sampler.randomBelow(startIdx - 1) + 1;            // [1, start - 1]
+        }
+        else {
+            endIdx = sampler.randomBelow(cells - 1 - startIdx) + startIdx + 1;  // [start + 1, cells - 1]
+        }
+        return makeRecord(startIdx, endIdx, isSnake);
+    }
+
+    static BoardEntityRecord makeRecord(int start, int end, bool isSnake) {
+        BoardEntityRecord record;
+        record.start = start;
+        record.end = end;
+        record.isSnake = isSnake;
+        return record;
+    }
+
 public:
     virtual void setupBoard(Board* board) = 0;
     virtual ~BoardSetupStrategy() {}
@@ -191,60 +1331,289 @@ public:
 private:
     Difficulty difficulty;
     
-    void setupWithProbability(Board* board, double snakeProbability) {
+    // Draws the entity records for one candidate board without adding them; rng null uses rand()
+    static vector<BoardEntityRecord> generateRecords(Board* board, double snakeProbability, FastRandom* rng = nullptr) {
         int totalCells = board->getBoardSize();
         int entityCount = totalCells / 10; // Roughly 10% of board has entities
+        vector<BoardEntityRecord> records;
+        
+        if(totalCells <= 10) {
+            cout << "Board is too small for random snakes and ladders." << endl;
+            return records;
+        }
+        
+        FreeCellSampler sampler(totalCells, occupiedStarts(board), rng);
+        records.reserve(entityCount);
         
         for(int i = 0; i < entityCount; i++) {
-            double randomVal = (double)rand() / RAND_MAX;
+            double randomVal = rng ? (double)(rng->next() >> 11) / 9007199254740992.0 : (double)rand() / RAND_MAX;
+            int snakeLow = snakeStartLow(), snakeHigh = snakeStartHigh(totalCells);
+            int ladderLow = ladderStartLow(), ladderHigh = ladderStartHigh(totalCells);
             
-            if(randomVal < snakeProbability) {
-                // Add snake
-                int attemptCount = 0;
-                while(attemptCount < 50) {
-                    int startIdx = rand() % (totalCells - 10) + 10;
-                    int endIdx = rand() % (startIdx - 1) + 1;
-                    
-                    if(board->canAddEntity(startIdx)) {
-                        board->addBoardEntity(new Snake(startIdx, endIdx));
-                        break;
-                    }
-                    attemptCount++;
-                }
-            } else {
-                // Add ladder
-                int attemptCount = 0;
-                while(attemptCount < 50) {
-                    int startIdx = rand() % (totalCells - 10) + 1;
-                    int endIdx = rand() % (totalCells - startIdx) + startIdx + 1;
-                    
-                    if(board->canAddEntity(startIdx) && endIdx < totalCells) {
-                        board->addBoardEntity(new Ladder(startIdx, endIdx));
-                        break;
-                    }
-                    attemptCount++;
-                }
+            // Fall back to the other kind only when a range is completely full
+            bool placeSnake = randomVal < snakeProbability;
+            if(placeSnake && sampler.countFree(snakeLow, snakeHigh) == 0) placeSnake = false;
+            if(!placeSnake && sampler.countFree(ladderLow, ladderHigh) == 0) placeSnake = true;
+            
+            if(placeSnake) {
+                if(sampler.countFree(snakeLow, snakeHigh) == 0) break;
+                records.push_back(placeEntity(sampler, totalCells, snakeLow, snakeHigh, true));
+            }
+            else {
+                records.push_back(placeEntity(sampler, totalCells, ladderLow, ladderHigh, false));
+            }
+        }
+        return records;
+    }
+    
+    void setupWithProbability(Board* board, double snakeProbability) {
+        board->addBoardEntities(generateRecords(board, snakeProbability));
+    }
+    
+    static vector<BoardEntityRecord> existingRecords(Board* board) {
+        vector<BoardEntityRecord> records;
+        for(auto entity : board->getEntities()) {
+            records.push_back(makeRecord(entity->getStart(), entity->getEnd(), entity->getEnd() < entity->getStart()));
+        }
+        return records;
+    }
+    
+    // Samples candidates until one lands in the difficulty's band, steering the snake ratio
+    // after each miss; if none does, the closest candidate is kept
+    void setupCalibrated(Board* board, const DifficultyBand& band) {
+        int cells = board->getBoardSize();
+        vector<BoardEntityRecord> existing = existingRecords(board);
+        vector<BoardEntityRecord> best;
+        double bestMiss = INFINITY;
+        double snakeProbability = snakeProbabilityFor(difficulty);
+        
+        for(int attempt = 0; attempt < maxCalibrationAttempts; attempt++) {
+            vector<BoardEntityRecord> records = generateRecords(board, snakeProbability);
+            vector<BoardEntityRecord> all = existing;
+            all.insert(all.end(), records.begin(), records.end());
+            double turns = DifficultyCalibration::expectedTurns(cells, all);
+            
+            double miss = turns < band.low ? band.low / turns - 1.0 : (turns > band.high ? turns / band.high - 1.0 : 0.0);
+            if(miss < bestMiss) {
+                bestMiss = miss;
+                best.swap(records);
             }
+            if(miss == 0.0) break;
+            snakeProbability = min(0.95, max(0.05, snakeProbability + (turns < band.low ? 0.05 : -0.05)));
         }
+        board->addBoardEntities(best);
     }
     
 public:
+    static const int maxCalibrationAttempts = 64;
+    
     RandomBoardSetupStrategy(Difficulty d) {
         difficulty = d;
     }
     
-    void setupBoard(Board* board) override {
-        switch(difficulty) {
+    static double snakeProbabilityFor(Difficulty d) {
+        switch(d) {
             case EASY:
-                setupWithProbability(board, 0.3);  // 30% snakes, 70% ladders
-                break;
-            case MEDIUM:
-                setupWithProbability(board, 0.5);  // 50% snakes, 50% ladders
-                break;
+                return 0.3;  // 30% snakes, 70% ladders
             case HARD:
-                setupWithProbability(board, 0.7);  // 70% snakes, 30% ladders
-                break;
+                return 0.7;  // 70% snakes, 30% ladders
+            default:
+                return 0.5;  // 50% snakes, 50% ladders
+        }
+    }
+    
+    // Boards outside the calibrated sizes only get the difficulty's snake ratio
+    void setupBoard(Board* board) override {
+        DifficultyBand band;
+        if(DifficultyCalibration::bandFor(board->getBoardSize(), difficulty, band)) {
+            setupCalibrated(board, band);
+        }
+        else {
+            setupWithProbability(board, snakeProbabilityFor(difficulty));
+        }
+    }
+    
+    // Measures the uncalibrated generator and prints DifficultyCalibration::rows
+    static void printCalibrationTable(int samples = 1000) {
+        const int sides[] = {4, 5, 6, 7, 8, 9, 10, 12, 15, 20, 25, 30, 40};
+        FastRandom rng(20240601);  // local stream: the game's rand() sequence is left alone
+        for(int side : sides) {
+            double median[3];
+            for(int d = EASY; d <= HARD; d++) {
+                vector<double> turns;
+                for(int i = 0; i < samples; i++) {
+                    Board board(side);
+                    vector<BoardEntityRecord> records = generateRecords(&board, snakeProbabilityFor((Difficulty)d), &rng);
+                    turns.push_back(DifficultyCalibration::expectedTurns(side * side, records));
+                }
+                nth_element(turns.begin(), turns.begin() + samples / 2, turns.end());
+                median[d] = turns[samples / 2];
+            }
+            
+            // +-15% around each median, split at the geometric midpoint where neighbours overlap
+            DifficultyBand bands[3];
+            for(int d = EASY; d <= HARD; d++) {
+                bands[d].low = median[d] * 0.85;
+                bands[d].high = median[d] * 1.15;
+            }
+            for(int d = EASY; d < HARD; d++) {
+                if(bands[d].high > bands[d + 1].low) {
+                    bands[d].high = bands[d + 1].low = sqrt(median[d] * median[d + 1]);
+                }
+            }
+            cout << "        {" << side << ", {";
+            for(int d = EASY; d <= HARD; d++) {
+                cout << (d > EASY ? ", " : "") << "{" << round(bands[d].low * 100) / 100 << ", " << round(bands[d].high * 100) / 100 << "}";
+            }
+            cout << "}}," << endl;
+        }
+    }
+};
+
+// Fork-join helper shared by everything that runs on several cores
+class WorkerThreads {
+public:
+    static int defaultCount() {
+        return max(1, (int)thread::hardware_concurrency());
+    }
+
+    // A positive request is used as given; 0 or less means one thread per core
+    static int resolve(int requested) {
+        return requested > 0 ? requested : defaultCount();
+    }
+
+    // Runs task on threadCount threads (including the caller) and waits for all of them
+    template <typename Task>
+    static void run(int threadCount, Task& task) {
+        vector<thread> workers;
+        for(int i = 1; i < threadCount; i++) {
+            workers.push_back(thread(ref(task)));
+        }
+        task();
+        for(auto& worker : workers) {
+            worker.join();
+        }
+    }
+};
+
+// Seeded stripe generator shared by the parallel strategies. Each fixed-size stripe of cells has its own
+// RNG substream derived from (seed, stripe), so output depends only on the seed, never on the thread count.
+class RandomStripeGenerator {
+public:
+    static const int64_t stripeCells = 1 << 16;
+
+    static uint64_t stripeSeed(uint64_t seed, uint64_t stripe) {
+        uint64_t z = seed ^ (stripe * 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Each cell starts an entity with probability 1/10; gaps between entities are drawn geometrically.
+    // Snakes start at 10 or above and ladders at most 10 below the end, as in RandomBoardSetupStrategy;
+    // a kind that cannot fit at a cell flips to the other kind. emit(start, end, isSnake) gets every entity.
+    template <typename Cell, typename Emit>
+    static void generateStripe(int64_t stripe, Cell totalCells, double snakeProbability, uint64_t seed, Emit emit) {
+        FastRandom rng(stripeSeed(seed, (uint64_t)stripe));
+        const double logSkip = log(1.0 - 0.1);
+        int64_t first = max((int64_t)1, stripe * stripeCells);
+        int64_t last = min((int64_t)totalCells - 1, (stripe + 1) * stripeCells - 1);
+        int64_t ladderHigh = (int64_t)totalCells - 10;
+
+        int64_t cell = first - 1;
+        while(true) {
+            double u = ((rng.next() >> 11) + 1) * (1.0 / 9007199254740992.0);  // (0, 1]
+            cell += 1 + (int64_t)(log(u) / logSkip);
+            if(cell > last) break;
+
+            bool isSnake = ((rng.next() >> 11) * (1.0 / 9007199254740992.0)) < snakeProbability;
+            uint64_t endBits = rng.next();
+
+            if(isSnake && cell < 10) isSnake = false;
+            if(!isSnake && cell > ladderHigh) isSnake = true;
+            if(isSnake && cell < 10) continue;
+
+            int64_t endIdx;
+            if(isSnake) {
+                endIdx = (int64_t)(endBits % (uint64_t)(cell - 1)) + 1;
+            }
+            else {
+                endIdx = (int64_t)(endBits % (uint64_t)((int64_t)totalCells - 1 - cell)) + cell + 1;
+            }
+            emit((Cell)cell, (Cell)endIdx, isSnake);
+        }
+    }
+
+    // Generates every stripe in parallel, then concatenates the per-stripe outputs (already in cell order)
+    template <typename Record, typename Cell, typename MakeRecord>
+    static vector<Record> generate(Cell totalCells, double snakeProbability, uint64_t seed, int threadCount, MakeRecord makeRecord) {
+        int64_t stripeCount = ((int64_t)totalCells + stripeCells - 1) / stripeCells;
+        vector<vector<Record>> stripeRecords(stripeCount);
+
+        // Stripes are handed out dynamically; which thread runs a stripe does not affect its output
+        atomic<int64_t> nextStripe(0);
+        auto worker = [&]() {
+            for(int64_t stripe = nextStripe++; stripe < stripeCount; stripe = nextStripe++) {
+                vector<Record>& out = stripeRecords[stripe];
+                generateStripe(stripe, totalCells, snakeProbability, seed, [&](Cell start, Cell end, bool isSnake) {
+                    out.push_back(makeRecord(start, end, isSnake));
+                });
+            }
+        };
+        WorkerThreads::run(threadCount, worker);
+
+        vector<Record> records;
+        vector<size_t> offsets(stripeCount + 1, 0);
+        for(int64_t stripe = 0; stripe < stripeCount; stripe++) {
+            offsets[stripe + 1] = offsets[stripe] + stripeRecords[stripe].size();
+        }
+        records.resize(offsets[stripeCount]);
+
+        nextStripe = 0;
+        auto concatenate = [&]() {
+            for(int64_t stripe = nextStripe++; stripe < stripeCount; stripe = nextStripe++) {
+                copy(stripeRecords[stripe].begin(), stripeRecords[stripe].end(), records.begin() + offsets[stripe]);
+                vector<Record>().swap(stripeRecords[stripe]);
+            }
+        };
+        WorkerThreads::run(threadCount, concatenate);
+        return records;
+    }
+};
+
+// Parallel Random Strategy - seeded and deterministic, for very large boards
+class ParallelRandomBoardSetupStrategy : public BoardSetupStrategy {
+private:
+    RandomBoardSetupStrategy::Difficulty difficulty;
+    uint64_t boardSeed;
+    int threadCount;
+    
+public:
+    ParallelRandomBoardSetupStrategy(RandomBoardSetupStrategy::Difficulty d, uint64_t seed, int threads = 0) {
+        difficulty = d;
+        boardSeed = seed;
+        threadCount = WorkerThreads::resolve(threads);
+    }
+    
+    void setupBoard(Board* board) override {
+        int totalCells = board->getBoardSize();
+        if(totalCells <= 10) {
+            cout << "Board is too small for random snakes and ladders." << endl;
+            return;
+        }
+        
+        double snakeProbability = RandomBoardSetupStrategy::snakeProbabilityFor(difficulty);
+        vector<BoardEntityRecord> records = RandomStripeGenerator::generate<BoardEntityRecord>(
+            totalCells, snakeProbability, boardSeed, threadCount, makeRecord);
+        
+        // Pre-existing starts win any conflict
+        if(!board->getEntities().empty()) {
+            vector<bool> occupied = occupiedStarts(board);
+            records.erase(remove_if(records.begin(), records.end(),
+                [&](const BoardEntityRecord& record) { return occupied[record.start]; }), records.end());
         }
+        
+        board->addBoardEntities(records);
     }
 };
 
@@ -276,304 +1645,4571 @@ public:
         if(useRandomPlacement) {
             // Random placement with user-defined counts
             int totalCells = board->getBoardSize();
+            if(totalCells <= 10) {
+                cout << "Board is too small for random snakes and ladders." << endl;
+                return;
+            }
             
-            // Add snakes
-            int snakesAdded = 0;
-            while(snakesAdded < snakeCount) {
-                int startIdx = rand() % (totalCells - 10) + 10;
-                int endIdx = rand() % (startIdx - 1) + 1;
-                
-                if(board->canAddEntity(startIdx)) {
-                    board->addBoardEntity(new Snake(startIdx, endIdx));
-                    snakesAdded++;
+            FreeCellSampler sampler(totalCells, occupiedStarts(board));
+            int snakeLow = snakeStartLow(), snakeHigh = snakeStartHigh(totalCells);
+            int ladderLow = ladderStartLow(), ladderHigh = ladderStartHigh(totalCells);
+            
+            // Snakes and ladders compete for the shared middle of the board
+            int sharedFree = sampler.countFree(snakeLow, ladderHigh);
+            int snakeOnlyFree = sampler.countFree(max(snakeLow, ladderHigh + 1), snakeHigh);
+            int ladderOnlyFree = sampler.countFree(ladderLow, min(ladderHigh, snakeLow - 1));
+            
+            if(snakeCount > snakeOnlyFree + sharedFree || ladderCount > ladderOnlyFree + sharedFree
+                || snakeCount + ladderCount > snakeOnlyFree + ladderOnlyFree + sharedFree) {
+                cout << "Cannot place " << snakeCount << " snakes and " << ladderCount << " ladders: only "
+                     << snakeOnlyFree + sharedFree << " snake starts and " << ladderOnlyFree + sharedFree
+                     << " ladder starts are free (" << snakeOnlyFree + ladderOnlyFree + sharedFree << " in total)." << endl;
+                return;
+            }
+            
+            // Snakes may only take as many shared cells as the ladders can spare
+            int sharedForSnakes = sharedFree - max(0, ladderCount - ladderOnlyFree);
+            vector<BoardEntityRecord> records;
+            records.reserve(snakeCount + ladderCount);
+            
+            for(int i = 0; i < snakeCount; i++) {
+                int low = snakeLow;
+                if(sampler.countFree(snakeLow, ladderHigh) <= sharedFree - sharedForSnakes) {
+                    low = max(snakeLow, ladderHigh + 1);  // shared budget used up
+                }
+                records.push_back(placeEntity(sampler, totalCells, low, snakeHigh, true));
+            }
+            
+            for(int i = 0; i < ladderCount; i++) {
+                records.push_back(placeEntity(sampler, totalCells, ladderLow, ladderHigh, false));
+            }
+            
+            board->addBoardEntities(records);
+        } 
+        else {
+            // User-defined positions. Bad entries are skipped one by one so the rest still go
+            // in, and the survivors are merged into the board in one bulk insert.
+            int totalCells = board->getBoardSize();
+            vector<bool> occupied = occupiedStarts(board);
+            vector<BoardEntityRecord> records;
+            records.reserve(snakePlacements.size() + ladderPlacements.size());
+            auto place = [&](const pair<int, int>& pos, bool isSnake) {
+                if(pos.first < 1 || pos.first >= totalCells || pos.second < 1 || pos.second > totalCells
+                   || (isSnake ? pos.second >= pos.first : pos.second <= pos.first)) {
+                    cout << "Invalid " << (isSnake ? "snake" : "ladder") << " " << pos.first << " -> " << pos.second << "." << endl;
+                    return;
+                }
+                if(!occupied[pos.first]) {
+                    occupied[pos.first] = true;
+                    records.push_back(BoardEntityRecord{pos.first, pos.second, isSnake});
+                }
+            };
+            for(auto& pos : snakePlacements) place(pos, true);
+            for(auto& pos : ladderPlacements) place(pos, false);
+            
+            board->addBoardEntities(records);
+        }
+    }
+};
+
+// Board file loader - one entity per line, either "S 99 54" / "L 2 38" or CSV "snake,99,54".
+// The kind is S, L, snake or ladder in any case. Blank lines and lines starting with '#' are ignored.
+class BoardFileLoader {
+private:
+    static bool isSeparator(char c) {
+        return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r';
+    }
+
+    static const char* skipSeparators(const char* p, const char* end) {
+        while(p < end && isSeparator(*p)) p++;
+        return p;
+    }
+
+    static bool reportError(int lineNumber, string msg) {
+        cout << "Board file error on line " << lineNumber << ": " << msg << endl;
+        return false;
+    }
+
+    // Case-insensitive comparison of [begin, end) with a lowercase word
+    static bool isWord(const char* begin, const char* end, const char* word) {
+        size_t length = strlen(word);
+        if((size_t)(end - begin) != length) return false;
+        for(size_t i = 0; i < length; i++) {
+            if(tolower((unsigned char)begin[i]) != word[i]) return false;
+        }
+        return true;
+    }
+
+public:
+    // Parses and validates the whole buffer in one pass; records are only returned if every line is valid
+    static bool parse(const char* data, size_t length, int cellCount, vector<BoardEntityRecord>& records) {
+        const char* p = data;
+        const char* end = data + length;
+        vector<bool> usedStarts(cellCount + 1, false);
+        int lineNumber = 0;
+
+        records.clear();
+        records.reserve(length / 8);
+
+        while(p < end) {
+            lineNumber++;
+            const char* lineEnd = (const char*)memchr(p, '\n', end - p);
+            if(lineEnd == nullptr) lineEnd = end;
+
+            const char* q = skipSeparators(p, lineEnd);
+            if(q == lineEnd || *q == '#') {
+                p = (lineEnd == end) ? end : lineEnd + 1;
+                continue;
+            }
+
+            // Entity kind: S or snake, L or ladder, in any case
+            const char* kindStart = q;
+            while(q < lineEnd && !isSeparator(*q)) q++;
+            char kind = 0;
+            if(isWord(kindStart, q, "s") || isWord(kindStart, q, "snake")) kind = 'S';
+            else if(isWord(kindStart, q, "l") || isWord(kindStart, q, "ladder")) kind = 'L';
+            if(kind == 0) {
+                return reportError(lineNumber, "unknown entity kind '" + string(kindStart, q) + "'");
+            }
+
+            int start = 0, finish = 0;
+            q = skipSeparators(q, lineEnd);
+            auto parsedStart = from_chars(q, lineEnd, start);
+            if(parsedStart.ec != errc()) {
+                return reportError(lineNumber, "expected start index");
+            }
+            q = skipSeparators(parsedStart.ptr, lineEnd);
+            auto parsedEnd = from_chars(q, lineEnd, finish);
+            if(parsedEnd.ec != errc()) {
+                return reportError(lineNumber, "expected end index");
+            }
+            if(skipSeparators(parsedEnd.ptr, lineEnd) != lineEnd) {
+                return reportError(lineNumber, "unexpected trailing characters");
+            }
+
+            if(start < 1 || start >= cellCount || finish < 1 || finish > cellCount) {
+                return reportError(lineNumber, "index outside the board");
+            }
+            if(kind == 'S' && finish >= start) {
+                return reportError(lineNumber, "snake must end below its start");
+            }
+            if(kind == 'L' && finish <= start) {
+                return reportError(lineNumber, "ladder must end above its start");
+            }
+            if(usedStarts[start]) {
+                return reportError(lineNumber, "cell " + to_string(start) + " already starts an entity");
+            }
+            usedStarts[start] = true;
+
+            BoardEntityRecord record;
+            record.start = start;
+            record.end = finish;
+            record.isSnake = (kind == 'S');
+            records.push_back(record);
+
+            p = (lineEnd == end) ? end : lineEnd + 1;
+        }
+        return true;
+    }
+
+    static bool load(string path, int cellCount, vector<BoardEntityRecord>& records) {
+        ifstream in(path, ios::binary);
+        if(!in) {
+            cout << "Unable to open board file: " << path << endl;
+            return false;
+        }
+
+        // Single bulk read; parsing then works in place on the buffer
+        string buffer;
+        in.seekg(0, ios::end);
+        streamoff size = in.tellg();
+        in.seekg(0, ios::beg);
+        in.peek();  // fails on paths that open but cannot be read, such as directories
+        if(size < 0 || !in) {
+            cout << "Unable to read board file: " << path << endl;
+            return false;
+        }
+        buffer.resize((size_t)size);
+        if(size > 0 && !in.read(&buffer[0], (streamsize)buffer.size())) {
+            cout << "Unable to read board file: " << path << endl;
+            return false;
+        }
+
+        return parse(buffer.data(), buffer.size(), cellCount, records);
+    }
+
+    // One "S start end" / "L start end" line per record, readable by parse()
+    static void write(ostream& out, const vector<BoardEntityRecord>& records) {
+        for(auto& record : records) {
+            out << (record.isSnake ? 'S' : 'L') << ' ' << record.start << ' ' << record.end << '\n';
+        }
+    }
+};
+
+// File Strategy - entities loaded from a board file
+class FileBoardSetupStrategy : public BoardSetupStrategy {
+private:
+    string filePath;
+    bool loaded;
+
+public:
+    FileBoardSetupStrategy(string path) {
+        filePath = path;
+        loaded = false;
+    }
+
+    void setupBoard(Board* board) override {
+        vector<BoardEntityRecord> records;
+        loaded = BoardFileLoader::load(filePath, board->getBoardSize(), records) && board->addBoardEntities(records);
+    }
+
+    // False when the last setupBoard() could not read or place the file's entities
+    bool isLoaded() {
+        return loaded;
+    }
+};
+
+// Standard board layout, fixed at compile time together with its expected-turns table
+class StandardBoardLayout {
+public:
+    static constexpr int cells = 100;
+    static constexpr int faces = 6;
+    static constexpr int entityCount = 21;
+    
+    // Traditional positions, sorted by start so the bulk load needs no sort
+    static constexpr BoardEntityRecord entities[entityCount] = {
+        {2, 38, false}, {7, 14, false}, {8, 31, false}, {15, 26, false}, {16, 6, true},
+        {21, 42, false}, {28, 84, false}, {36, 44, false}, {46, 25, true}, {49, 11, true},
+        {51, 67, false}, {62, 19, true}, {64, 60, true}, {71, 91, false}, {74, 53, true},
+        {78, 98, false}, {87, 94, false}, {89, 68, true}, {92, 88, true}, {95, 75, true},
+        {99, 54, true}
+    };
+    
+    static constexpr int landingCell(int cell) {
+        for(int i = 0; i < entityCount; i++) {
+            if(entities[i].start == cell) return entities[i].end;
+        }
+        return cell;
+    }
+    
+    // (cell, face) -> cell under the standard rules: exact roll needed, one hop per entity
+    static constexpr array<int, (cells + 1) * faces> buildTransitions() {
+        array<int, (cells + 1) * faces> table{};
+        for(int cell = 0; cell <= cells; cell++) {
+            for(int face = 1; face <= faces; face++) {
+                int target = cell + face;
+                table[cell * faces + face - 1] = (cell == cells || target > cells) ? cell : landingCell(target);
+            }
+        }
+        return table;
+    }
+    
+    // Same Gauss-Seidel solve as BoardAnalyzer, evaluated by the compiler
+    static constexpr array<double, cells + 1> buildExpectedTurns(const array<int, (cells + 1) * faces>& transitions) {
+        array<double, cells + 1> expected{};
+        for(int sweep = 0; sweep < 20000; sweep++) {
+            double maxChange = 0.0;
+            for(int cell = cells - 1; cell >= 0; cell--) {
+                double sum = 1.0;
+                double stayProbability = 0.0;
+                for(int face = 1; face <= faces; face++) {
+                    int target = transitions[cell * faces + face - 1];
+                    if(target == cell) stayProbability += 1.0 / faces;
+                    else sum += expected[target] / faces;
+                }
+                double value = sum / (1.0 - stayProbability);
+                double change = value > expected[cell] ? value - expected[cell] : expected[cell] - value;
+                if(change > maxChange) maxChange = change;
+                expected[cell] = value;
+            }
+            if(maxChange < 1e-12) break;
+        }
+        return expected;
+    }
+};
+
+// Tables generated from the layout at compile time
+class StandardBoardTables {
+public:
+    static constexpr array<double, StandardBoardLayout::cells + 1> expectedTurns =
+        StandardBoardLayout::buildExpectedTurns(StandardBoardLayout::buildTransitions());
+};
+
+static_assert(StandardBoardTables::expectedTurns[StandardBoardLayout::cells] == 0.0, "final cell is absorbing");
+static_assert(StandardBoardTables::expectedTurns[0] > 40.0 && StandardBoardTables::expectedTurns[0] < 60.0,
+              "standard board takes about 50 turns");
+
+// Standard Board Strategy - Traditional Snake & Ladder positions
+class StandardBoardSetupStrategy : public BoardSetupStrategy {
+public:
+    void setupBoard(Board* board) override {
+        // Only works for 10x10 board (100 cells)
+        if(board->getBoardSize() != StandardBoardLayout::cells) {
+            cout << "Standard configuration supports only a 10x10 board (100 cells)." << endl;
+            return;
+        }
+        
+        board->addBoardEntities(vector<BoardEntityRecord>(StandardBoardLayout::entities,
+                                                          StandardBoardLayout::entities + StandardBoardLayout::entityCount));
+    }
+    
+    // One immutable standard board shared by every standard game; built on first use only.
+    // setupBoard() builds the lookup and resolveChains() the chain table before the board is
+    // published, so games on other threads only ever read them and never trigger a lazy rebuild.
+    static Board* sharedBoard() {
+        static Board* board = []() {
+            Board* b = new Board(10);
+            StandardBoardSetupStrategy strategy;
+            b->setupBoard(&strategy);
+            b->resolveChains();
+            return b;
+        }();
+        return board;
+    }
+};
+
+// Now defining setupBoard for Board class
+void Board::setupBoard(BoardSetupStrategy* strategy) {
+    strategy->setupBoard(this);
+    buildLookup();
+}
+
+// Player class
+class SnakeAndLadderPlayer {
+private:
+    int id;
+    string playerName;
+    int currentPosition;
+    int winCount;
+    int consecutiveSixes;
+    
+public:
+    SnakeAndLadderPlayer(int playerId, string n) {
+        this->id = playerId;
+        playerName = n;
+        currentPosition = 0;
+        winCount = 0;
+        consecutiveSixes = 0;
+    }
+    
+    // Getters and Setters
+    string getName() { 
+        return playerName;
+    }
+    int getPosition() { 
+        return currentPosition; 
+    }
+    void setPosition(int pos) { 
+        currentPosition = pos; 
+    }
+    int getScore() { 
+        return winCount;
+    }
+    void incrementScore() { 
+        winCount++; 
+    }
+    int getConsecutiveSixes() {
+        return consecutiveSixes;
+    }
+    void setConsecutiveSixes(int count) {
+        consecutiveSixes = count;
+    }
+};
+
+// Strategy Pattern for game rules
+class SnakeAndLadderRules {
+public:
+    virtual bool isValidMove(int currentPos, int diceValue, int boardSize) = 0;
+    virtual int calculateNewPosition(int currentPos, int diceValue, Board* board) = 0;
+    virtual bool checkWinCondition(int position, int boardSize) = 0;
+    virtual string getRulesId() = 0;  // identifies the rule set in board hashes
+    // Called before play or analysis so rules can precompute per-board data; false rejects the board
+    virtual bool bindBoard(Board*) { return true; }
+    // Cell the roll lands on before any snake or ladder is applied
+    virtual int getLandingCell(int currentPos, int diceValue, int) { return currentPos + diceValue; }
+    virtual bool grantsExtraTurn(int) { return false; }
+    // Number of sixes in a row that forfeits the move (0 = never)
+    virtual int getForfeitSixCount() { return 0; }
+    // True when a move can depend on other players' positions (e.g. bumping); disables
+    // analyses that treat every player as an independent walk
+    virtual bool playersInteract() { return false; }
+    virtual ~SnakeAndLadderRules() {}
+};
+
+// Standard rules
+class StandardSnakeAndLadderRules : public SnakeAndLadderRules {
+public:
+    bool isValidMove(int currentPos, int diceValue, int boardSize) override {
+        return (currentPos + diceValue) <= boardSize;
+    }
+    
+    int calculateNewPosition(int currentPos, int diceValue, Board* board) override {
+        int newPos = currentPos + diceValue;
+        BoardEntity* entity = board->getEntity(newPos);
+        
+        if(entity != nullptr) {
+            return entity->getEnd();
+        }
+        return newPos;
+    }
+    
+    bool checkWinCondition(int position, int boardSize) override {
+        return position == boardSize;
+    }
+
+    string getRulesId() override {
+        return "STANDARD";
+    }
+};
+
+// Chained rules - a snake or ladder that ends on another entity's start is followed through.
+// Chains are resolved once when the board is bound, so each move stays O(1); boards with cycles are rejected.
+class ChainedSnakeAndLadderRules : public StandardSnakeAndLadderRules {
+public:
+    int calculateNewPosition(int currentPos, int diceValue, Board* board) override {
+        return board->getChainedDestination(currentPos + diceValue);
+    }
+    
+    string getRulesId() override {
+        return "CHAINED";
+    }
+    
+    bool bindBoard(Board* board) override {
+        return board->resolveChains();
+    }
+};
+
+// Composable house rules. RuleSetSnakeAndLadderRules plays them and TransitionTable compiles them.
+struct RuleSet {
+    bool bounceBack = false;               // overshooting the final cell bounces back by the excess
+    bool exactRollToFinish = true;         // false: reaching or passing the final cell wins
+    bool extraTurnOnSix = false;
+    bool forfeitAfterThreeSixes = false;   // the third six in a row is forfeited and ends the turn
+    bool noSnakesInFirstRow = false;       // snakes starting in the first row are inactive
+    
+    string getId() const {
+        string id = "RULESET";
+        if(bounceBack) id += ":BOUNCE";
+        if(!exactRollToFinish) id += ":NO_EXACT";
+        if(extraTurnOnSix) id += ":EXTRA_SIX";
+        if(forfeitAfterThreeSixes) id += ":FORFEIT_3_SIX";
+        if(noSnakesInFirstRow) id += ":SAFE_FIRST_ROW";
+        return id;
+    }
+};
+
+// Rules driven by a RuleSet
+class RuleSetSnakeAndLadderRules : public SnakeAndLadderRules {
+private:
+    RuleSet ruleSet;
+    
+public:
+    RuleSetSnakeAndLadderRules(RuleSet r) {
+        ruleSet = r;
+    }
+    
+    bool isValidMove(int currentPos, int diceValue, int boardSize) override {
+        return ruleSet.bounceBack || !ruleSet.exactRollToFinish || (currentPos + diceValue) <= boardSize;
+    }
+    
+    int getLandingCell(int currentPos, int diceValue, int boardSize) override {
+        int target = currentPos + diceValue;
+        if(target <= boardSize) return target;
+        if(ruleSet.bounceBack) return max(0, 2 * boardSize - target);
+        if(!ruleSet.exactRollToFinish) return boardSize;
+        return currentPos;
+    }
+    
+    int calculateNewPosition(int currentPos, int diceValue, Board* board) override {
+        int landing = getLandingCell(currentPos, diceValue, board->getBoardSize());
+        BoardEntity* entity = board->getEntity(landing);
+        if(entity == nullptr) {
+            return landing;
+        }
+        
+        int rowLength = (int)llround(sqrt((double)board->getBoardSize()));
+        if(ruleSet.noSnakesInFirstRow && entity->getEnd() < landing && landing <= rowLength) {
+            return landing;
+        }
+        return entity->getEnd();
+    }
+    
+    bool checkWinCondition(int position, int boardSize) override {
+        return position == boardSize;
+    }
+    
+    string getRulesId() override {
+        return ruleSet.getId();
+    }
+    
+    bool grantsExtraTurn(int diceValue) override {
+        return ruleSet.extraTurnOnSix && diceValue == 6;
+    }
+    
+    int getForfeitSixCount() override {
+        return ruleSet.forfeitAfterThreeSixes ? 3 : 0;
+    }
+};
+
+// Game class
+class SnakeAndLadderGame {
+private:
+    Board* gameBoard;
+    Dice* gameDice;
+    deque<SnakeAndLadderPlayer*> turnQueue;
+    SnakeAndLadderRules* gameRules;
+    vector<IObserver*> subscriberList;
+    bool isGameOver;
+    
+public:
+    SnakeAndLadderGame(Board* b, Dice* d) {
+        gameBoard = b;
+        gameDice = d;
+        gameRules = new StandardSnakeAndLadderRules();
+        isGameOver = false;
+    }
+    
+    void addPlayer(SnakeAndLadderPlayer* player) {
+        turnQueue.push_back(player);
+    }
+    
+    void addObserver(IObserver* observer) {
+        subscriberList.push_back(observer);
+    }
+
+    // Read-only: standard games share one board (StandardBoardSetupStrategy::sharedBoard())
+    const Board* getBoard() const {
+        return gameBoard;
+    }
+
+    Dice* getDice() {
+        return gameDice;
+    }
+
+    SnakeAndLadderRules* getRules() {
+        return gameRules;
+    }
+    
+    // Game takes ownership of the rules
+    void setRules(SnakeAndLadderRules* rules) {
+        delete gameRules;
+        gameRules = rules;
+    }
+
+    void notify(string msg) {
+        for(auto observer : subscriberList) {
+            observer->update(msg);
+        }
+    }
+    
+    void displayPlayerPositions() {
+        cout << "\n=== Current Player Positions ===" << endl;
+        for(auto player : turnQueue) {
+            cout << player->getName() << ": " << player->getPosition() << endl;
+        }
+        cout << "==============================" << endl;
+    }
+    
+    void play() {
+        if(turnQueue.size() < 2) {
+            cout << "A minimum of 2 players is required to start the game." << endl;
+            return;
+        }
+        
+        if(!gameRules->bindBoard(gameBoard)) {
+            cout << "The board is not playable under the selected rules." << endl;
+            return;
+        }
+        
+        notify("Game initiated.");
+
+        gameBoard->display();
+        
+        while(!isGameOver) {
+            SnakeAndLadderPlayer* currentPlayer = turnQueue.front();
+            
+            cout << "\n" << currentPlayer->getName() << "'s turn. Press Enter to roll the dice...";
+            cin.ignore();
+            cin.get();
+            
+            int rollValue = gameDice->roll();
+            cout << "Dice result: " << rollValue << endl;
+            
+            // Sixes may grant another roll or, when too many come in a row, forfeit the move
+            int sixesInRow = (rollValue == 6) ? currentPlayer->getConsecutiveSixes() + 1 : 0;
+            int forfeitCount = gameRules->getForfeitSixCount();
+            if(forfeitCount > 0 && sixesInRow >= forfeitCount) {
+                cout << sixesInRow << " sixes in a row. Move forfeited." << endl;
+                notify(currentPlayer->getName() + " forfeited a move after " + to_string(sixesInRow) + " sixes in a row");
+                currentPlayer->setConsecutiveSixes(0);
+                turnQueue.pop_front();
+                turnQueue.push_back(currentPlayer);
+                continue;
+            }
+            currentPlayer->setConsecutiveSixes(sixesInRow);
+            bool extraTurn = gameRules->grantsExtraTurn(rollValue);
+            
+            int currentPos = currentPlayer->getPosition();
+            
+            if(gameRules->isValidMove(currentPos, rollValue, gameBoard->getBoardSize())) {
+                int intermediatePos = gameRules->getLandingCell(currentPos, rollValue, gameBoard->getBoardSize());
+                int newPos = gameRules->calculateNewPosition(currentPos, rollValue, gameBoard);
+                
+                currentPlayer->setPosition(newPos);
+                
+                // Check if player encountered snake or ladder
+                BoardEntity* entity = gameBoard->getEntity(intermediatePos);
+                if(entity != nullptr && newPos != intermediatePos) {
+                    bool encounteredSnake = (entity->name() == "SNAKE");
+                    if(encounteredSnake) {
+                        cout << "Encountered snake at " << intermediatePos << ". Moving down to " << newPos << "." << endl;
+                        notify(currentPlayer->getName() + " encountered a snake at " + to_string(intermediatePos) + " and moved down to " + to_string(newPos));
+                    }
+                    else {
+                        cout << "Encountered ladder at " << intermediatePos << ". Moving up to " << newPos << "." << endl;
+                        notify(currentPlayer->getName() + " encountered a ladder at " + to_string(intermediatePos) + " and moved up to " + to_string(newPos));
+                    }
+                }
+                
+                notify(currentPlayer->getName() + " completed a move. Current position: " + to_string(newPos));
+                displayPlayerPositions();
+                
+                if(gameRules->checkWinCondition(newPos, gameBoard->getBoardSize())) {
+                    cout << "\n" << currentPlayer->getName() << " has won the game." << endl;
+                    currentPlayer->incrementScore();
+
+                    notify(string("Game concluded. Winner: ") + currentPlayer->getName());
+                    isGameOver = true;
+                }
+                else if(extraTurn) {
+                    cout << "Rolled a " << rollValue << ": " << currentPlayer->getName() << " rolls again." << endl;
+                }
+                else {
+                    // Move player to back of queue
+                    turnQueue.pop_front();
+                    turnQueue.push_back(currentPlayer);
+                }
+            }
+            else {
+                cout << "Exact roll required to reach cell " << gameBoard->getBoardSize() << "." << endl;
+                if(extraTurn) {
+                    cout << "Rolled a " << rollValue << ": " << currentPlayer->getName() << " rolls again." << endl;
+                }
+                else {
+                    // Move player to back of queue
+                    turnQueue.pop_front();
+                    turnQueue.push_back(currentPlayer);
+                }
+            }
+        }
+    }
+    
+    ~SnakeAndLadderGame() {
+        delete gameRules;
+    }
+};
+
+// Factory Pattern
+class SnakeAndLadderGameFactory {
+public:
+    static SnakeAndLadderGame* createStandardGame() {
+        Board* board = StandardBoardSetupStrategy::sharedBoard();  // Standard 10x10 board, set up once
+        
+        Dice* dice = new Dice(6);  // Standard 6-faced dice
+        
+        return new SnakeAndLadderGame(board, dice);
+    }
+    
+    static SnakeAndLadderGame* createRandomGame(int boardSize, RandomBoardSetupStrategy::Difficulty difficulty) {
+        Board* board = new Board(boardSize);
+        BoardSetupStrategy* strategy = new RandomBoardSetupStrategy(difficulty);
+        board->setupBoard(strategy);
+        delete strategy;
+        
+        Dice* dice = new Dice(6);
+        
+        return new SnakeAndLadderGame(board, dice);
+    }
+    
+    static SnakeAndLadderGame* createCustomGame(int boardSize, BoardSetupStrategy* strategy) {
+        Board* board = new Board(boardSize);
+        board->setupBoard(strategy);
+        
+        Dice* dice = new Dice(6);
+        
+        return new SnakeAndLadderGame(board, dice);
+    }
+};
+
+// ===================== Board Analysis =====================
+
+// Flattened (state, dice value) -> state transitions, built once from the board and rules.
+// A state is a cell, augmented with the count of sixes in a row when the rules forfeit repeated sixes:
+// state = cell * sixStates + sixesInRow. Each transition also records whether it ends the turn.
+class TransitionTable {
+private:
+    int cellCount;
+    int faceCount;
+    int sixStates;
+    vector<int> nextState;   // stateCount * faceCount entries
+    vector<char> turnEnds;   // 0 when the roll earns another roll in the same turn
+    DiceDistribution dice;   // shared by the solver (probabilities) and the simulator (sampling)
+    int forfeitCount;
+    bool valid;              // false when the rules rejected the board (e.g. a cycle of chained entities)
+    vector<int> moved;       // scratch: destination per face for the cell being built
+
+    // Fills every (state, face) slot of one cell. Movement depends only on the cell,
+    // so the rules are evaluated once per face and reused for each six-count state.
+    void buildCell(Board* board, SnakeAndLadderRules* rules, int cell) {
+        for(int face = 1; face <= faceCount; face++) {
+            int target = cell;
+            if(cell != cellCount && rules->isValidMove(cell, face, cellCount)) {
+                target = rules->calculateNewPosition(cell, face, board);
+            }
+            moved[face - 1] = target;
+        }
+        
+        for(int sixes = 0; sixes < sixStates; sixes++) {
+            int state = cell * sixStates + sixes;
+            for(int face = 1; face <= faceCount; face++) {
+                size_t slot = (size_t)state * faceCount + face - 1;
+                bool six = (face == 6);
+                
+                if(cell == cellCount) {
+                    nextState[slot] = state;
+                    turnEnds[slot] = 1;
+                }
+                else if(six && forfeitCount > 0 && sixes + 1 >= forfeitCount) {
+                    nextState[slot] = cell * sixStates;
+                    turnEnds[slot] = 1;
+                }
+                else {
+                    int target = moved[face - 1];
+                    int nextSixes = (six && forfeitCount > 0 && target != cellCount) ? sixes + 1 : 0;
+                    nextState[slot] = target * sixStates + nextSixes;
+                    // Winning always ends the turn, so the winning turn is counted
+                    turnEnds[slot] = (rules->grantsExtraTurn(face) && target != cellCount) ? 0 : 1;
+                }
+            }
+        }
+    }
+
+public:
+    TransitionTable(Board* board, SnakeAndLadderRules* rules, int faces)
+        : TransitionTable(board, rules, DiceDistribution::fair(faces)) {}
+
+    TransitionTable(Board* board, SnakeAndLadderRules* rules, const DiceDistribution& d) : dice(d) {
+        cellCount = board->getBoardSize();
+        faceCount = dice.getMaxValue();
+        valid = rules->bindBoard(board);
+        
+        forfeitCount = rules->getForfeitSixCount();
+        sixStates = max(1, forfeitCount);
+        size_t stateCount = (size_t)(cellCount + 1) * sixStates;
+        nextState.resize(stateCount * faceCount);
+        turnEnds.resize(stateCount * faceCount);
+        moved.resize(faceCount);
+
+        for(int cell = 0; cell <= cellCount; cell++) {
+            buildCell(board, rules, cell);
+        }
+    }
+
+    // Re-evaluates one cell's rolls after the board changed; the rules must already be bound
+    void rebuildCell(Board* board, SnakeAndLadderRules* rules, int cell) {
+        if(cell >= 0 && cell < cellCount) {
+            buildCell(board, rules, cell);
+        }
+    }
+    
+    static TransitionTable compile(Board* board, const RuleSet& ruleSet, int faces) {
+        RuleSetSnakeAndLadderRules rules(ruleSet);
+        return TransitionTable(board, &rules, faces);
+    }
+
+    static TransitionTable compile(Board* board, const RuleSet& ruleSet, const DiceDistribution& dice) {
+        RuleSetSnakeAndLadderRules rules(ruleSet);
+        return TransitionTable(board, &rules, dice);
+    }
+
+    int getCellCount() {
+        return cellCount;
+    }
+
+    int getFaceCount() {
+        return faceCount;
+    }
+
+    // Analyses refuse tables whose board the rules rejected; the moves in them are not meaningful
+    bool isValid() {
+        return valid;
+    }
+
+    const DiceDistribution& getDice() {
+        return dice;
+    }
+
+    double faceProbability(int face) {
+        return dice.probability(face);
+    }
+    
+    int getStateCount() {
+        return (cellCount + 1) * sixStates;
+    }
+    
+    int getSixStates() {
+        return sixStates;
+    }
+    
+    // State of a player standing on cell with no sixes pending
+    int stateOf(int cell) {
+        return cell * sixStates;
+    }
+    
+    int cellOf(int state) {
+        return state / sixStates;
+    }
+    
+    bool isFinished(int state) {
+        return state >= cellCount * sixStates;
+    }
+
+    int next(int state, int face) {
+        return nextState[(size_t)state * faceCount + face - 1];
+    }
+    
+    bool endsTurn(int state, int face) {
+        return turnEnds[(size_t)state * faceCount + face - 1] != 0;
+    }
+};
+
+// Aitken extrapolation for repeated sweeps x <- F(x) whose slowest error mode decays by a factor
+// r per sweep: once r has been steady for a few sweeps, the remaining r / (1 - r) of that mode's
+// steps are added in one go. The ratio is only an estimate; when other modes are still large, or
+// when they oscillate, the jump amplifies them instead, so the sweep after a jump must move the
+// values less than the sweep before it did. If it does not, the jump is undone and sweeping
+// carries on without extrapolation.
+class SweepExtrapolator {
+private:
+    static constexpr int stableSweepsNeeded = 3;
+    static constexpr double maxRatio = 0.9999;  // caps a jump at 10^4 sweeps' worth
+
+    vector<double> previousDelta, beforeJump;
+    double previousRatio = 0.0;
+    int stableSweeps = 0;
+    double changeBeforeJump = 0.0;
+    bool checkingJump = false;
+    bool enabled = true;
+
+public:
+    // delta[i] is how far value(i) moved in the sweep just finished, and maxChange the largest
+    // |delta[i]|; value(i) returns a reference to the i-th swept value
+    template <typename Value>
+    void afterSweep(vector<double>& delta, double maxChange, Value value) {
+        if(checkingJump) {
+            checkingJump = false;
+            if(maxChange > changeBeforeJump) {
+                for(size_t i = 0; i < delta.size(); i++) {
+                    value(i) = beforeJump[i];
+                }
+                enabled = false;
+            }
+        }
+        if(!enabled) return;
+
+        if(!previousDelta.empty()) {
+            double dotCurrent = 0.0, dotPrevious = 0.0;
+            for(size_t i = 0; i < delta.size(); i++) {
+                dotCurrent += delta[i] * previousDelta[i];
+                dotPrevious += previousDelta[i] * previousDelta[i];
+            }
+            double ratio = dotPrevious > 0.0 ? dotCurrent / dotPrevious : 0.0;
+            // Steady means the jump length r / (1 - r) moved by under 1% since the last sweep
+            bool steady = ratio > 0.0 && ratio < maxRatio && fabs(ratio - previousRatio) < 1e-2 * (1.0 - ratio);
+            stableSweeps = steady ? stableSweeps + 1 : 0;
+            previousRatio = ratio;
+
+            if(stableSweeps >= stableSweepsNeeded) {
+                beforeJump.resize(delta.size());
+                for(size_t i = 0; i < delta.size(); i++) {
+                    beforeJump[i] = value(i);
+                    value(i) += ratio / (1.0 - ratio) * delta[i];
+                }
+                changeBeforeJump = maxChange;
+                checkingJump = true;
+                previousDelta.clear();  // restart the ratio estimate after extrapolating
+                previousRatio = 0.0;
+                stableSweeps = 0;
+                return;
+            }
+        }
+        previousDelta = delta;
+    }
+};
+
+// Exact single-player solver: expected turns to finish from every state
+class BoardAnalyzer {
+public:
+    static vector<double> faceProbabilities(TransitionTable& table) {
+        vector<double> probability(table.getFaceCount() + 1, 0.0);
+        for(int face = 1; face <= table.getFaceCount(); face++) {
+            probability[face] = table.faceProbability(face);
+        }
+        return probability;
+    }
+
+    // One state's expected turns from its successors' current values. Rolls that stay put
+    // are folded into the denominator; rolls that earn another roll cost no turn.
+    static double stateValue(TransitionTable& table, const vector<double>& faceProbability,
+                             const vector<double>& expectedTurns, int state) {
+        double sum = 0.0;
+        double stayProbability = 0.0;
+        for(int face = 1; face < (int)faceProbability.size(); face++) {
+            double p = faceProbability[face];
+            if(p == 0.0) continue;
+            int target = table.next(state, face);
+            if(table.endsTurn(state, face)) {
+                sum += p;
+            }
+            if(target == state) {
+                stayProbability += p;
+            }
+            else {
+                sum += p * expectedTurns[target];
+            }
+        }
+        return sum / (1.0 - stayProbability);
+    }
+
+    // Gauss-Seidel sweeps: values[state] = update(state) for each state in order, repeated
+    // until no value moves by more than tolerance * max(1, values[scaleState]). Snakes make
+    // these systems non-triangular, and on snake-heavy boards the slowest error mode decays
+    // by a factor close to 1 per sweep; SweepExtrapolator removes that mode once it is steady.
+    template <typename Update>
+    static bool iterate(vector<double>& values, const vector<int>& order, Update update, int scaleState,
+                        double tolerance, int maxSweeps = 100000) {
+        vector<double> delta(order.size());
+        SweepExtrapolator extrapolator;
+
+        for(int sweep = 0; sweep < maxSweeps; sweep++) {
+            double maxChange = 0.0;
+            for(size_t i = 0; i < order.size(); i++) {
+                int state = order[i];
+                double value = update(state);
+                delta[i] = value - values[state];
+                maxChange = max(maxChange, fabs(delta[i]));
+                values[state] = value;
+            }
+
+            if(maxChange < tolerance * max(1.0, values[scaleState])) {
+                return true;
+            }
+            extrapolator.afterSweep(delta, maxChange, [&](size_t i) -> double& { return values[order[i]]; });
+        }
+        return false;
+    }
+
+    // Expected turns for the given states (highest first), starting from the values already there
+    static bool sweepStates(TransitionTable& table, vector<double>& expectedTurns, const vector<int>& states,
+                            double tolerance, int maxSweeps = 100000) {
+        vector<double> faceProbability = faceProbabilities(table);
+        auto update = [&](int state) { return stateValue(table, faceProbability, expectedTurns, state); };
+        if(!iterate(expectedTurns, states, update, table.stateOf(0), tolerance, maxSweeps)) {
+            cout << "Expected turns did not converge; the final cell may be unreachable." << endl;
+            return false;
+        }
+        return true;
+    }
+
+    // expectedTurns is indexed by state (see stateOf)
+    static bool solveExpectedTurns(TransitionTable& table, vector<double>& expectedTurns, double tolerance = 1e-10) {
+        if(!table.isValid()) {
+            cout << "The rules reject this board; expected turns cannot be computed." << endl;
+            return false;
+        }
+        int finished = table.stateOf(table.getCellCount());
+        expectedTurns.assign(table.getStateCount(), 0.0);
+
+        vector<int> states(finished);
+        for(int i = 0; i < finished; i++) {
+            states[i] = finished - 1 - i;
+        }
+        return sweepStates(table, expectedTurns, states, tolerance);
+    }
+};
+
+// Exact expected turns from the start for many boards of one size at once (standard rules,
+// fair dice). Same elimination as DifficultyCalibration::expectedTurns, but boards are
+// interleaved lane by lane in groups of eight: every form is stored [coefficient][lane], so the
+// sweep down the board is plain element-wise arithmetic on eight boards at a time that the
+// compiler can keep in vector registers. Entities are applied per lane from an event list
+// bucketed by cell. Unknowns are numbered by snake start, highest first, so above the k-th
+// highest start a form has only k coefficients; boards are grouped by snake count so the
+// lanes of a group stay aligned.
+class BatchBoardSolver {
+public:
+    static const int lanes = 8;
+
+private:
+    enum EventKind {
+        RECORD_ROW,    // cell is a snake destination: its value defines unknown `slot`
+        KEEP_FORM,     // cell is a ladder destination: its value is kept in form `slot`
+        LAND_UNKNOWN,  // cell starts a snake: landing here is unknown `slot`
+        LAND_KEPT      // cell starts a ladder: landing here is kept form `slot`
+    };
+
+    struct Event {
+        int lane;
+        int kind;
+        int slot;
+    };
+
+    // Per-thread scratch for one group, reused across groups
+    struct Group {
+        int unknowns;               // widest lane's snake-destination count
+        int kept;                   // widest lane's ladder-destination count
+        vector<int> activeAt;       // form width needed at each cell
+        vector<int> eventOffsets;   // events of cell c: destinations in bucket 2c, starts in 2c + 1
+        vector<Event> events;
+        vector<int> eventKey;       // scratch for the bucketing
+        vector<Event> unsorted;
+        vector<int> rowSlot, keepSlot;  // per-lane destination -> slot, all -1 between lanes
+        vector<BoardEntityRecord> snakes;
+        vector<double> window, sum, keptForms, matrix, rhs;
+    };
+
+    static void addEvent(Group& group, int key, int lane, int kind, int slot) {
+        group.eventKey.push_back(key);
+        group.unsorted.push_back(Event{lane, kind, slot});
+    }
+
+    static void load(Group& group, int cells, const vector<vector<BoardEntityRecord>>& boards, const int* members, int count) {
+        if((int)group.rowSlot.size() != cells + 1) {
+            group.rowSlot.assign(cells + 1, -1);
+            group.keepSlot.assign(cells + 1, -1);
+        }
+        group.activeAt.assign(cells + 1, 1);
+        group.eventKey.clear();
+        group.unsorted.clear();
+        group.unknowns = 0;
+        group.kept = 0;
+
+        for(int lane = 0; lane < count; lane++) {
+            const vector<BoardEntityRecord>& records = boards[members[lane]];
+            int unknowns = 0, kept = 0;
+            group.snakes.clear();
+            for(auto& record : records) {
+                if(record.isSnake) {
+                    group.snakes.push_back(record);
+                    continue;
+                }
+                int& slot = group.keepSlot[record.end];
+                if(slot < 0) {
+                    slot = kept++;
+                    addEvent(group, 2 * record.end, lane, KEEP_FORM, slot);
+                }
+                addEvent(group, 2 * record.start + 1, lane, LAND_KEPT, slot);
+            }
+
+            // Boards usually arrive sorted by start, so reversing is enough
+            if(is_sorted(group.snakes.begin(), group.snakes.end(),
+                         [](const BoardEntityRecord& x, const BoardEntityRecord& y) { return x.start < y.start; })) {
+                reverse(group.snakes.begin(), group.snakes.end());
+            }
+            else {
+                sort(group.snakes.begin(), group.snakes.end(),
+                    [](const BoardEntityRecord& x, const BoardEntityRecord& y) { return x.start > y.start; });
+            }
+            for(auto& record : group.snakes) {
+                int& slot = group.rowSlot[record.end];
+                if(slot < 0) {
+                    slot = unknowns++;
+                    addEvent(group, 2 * record.end, lane, RECORD_ROW, slot);
+                }
+                addEvent(group, 2 * record.start + 1, lane, LAND_UNKNOWN, slot);
+                // Below this start the form needs the slot's coefficient
+                group.activeAt[record.start - 1] = max(group.activeAt[record.start - 1], slot + 2);
+            }
+
+            for(auto& record : records) {
+                group.rowSlot[record.end] = -1;
+                group.keepSlot[record.end] = -1;
+            }
+            group.unknowns = max(group.unknowns, unknowns);
+            group.kept = max(group.kept, kept);
+        }
+        for(int cell = cells - 1; cell >= 0; cell--) {
+            group.activeAt[cell] = max(group.activeAt[cell], group.activeAt[cell + 1]);
+        }
+
+        // Counting sort of the events into per-cell buckets
+        int buckets = 2 * (cells + 1);
+        group.eventOffsets.assign(buckets + 1, 0);
+        for(int key : group.eventKey) group.eventOffsets[key + 1]++;
+        for(int i = 0; i < buckets; i++) group.eventOffsets[i + 1] += group.eventOffsets[i];
+        group.events.resize(group.unsorted.size());
+        for(size_t i = 0; i < group.unsorted.size(); i++) {
+            group.events[group.eventOffsets[group.eventKey[i]]++] = group.unsorted[i];
+        }
+        for(int i = buckets; i > 0; i--) group.eventOffsets[i] = group.eventOffsets[i - 1];
+        group.eventOffsets[0] = 0;
+    }
+
+    // Forms are [constant, coefficient of each unknown] x lanes, coefficient-major
+    static void solveGroup(Group& group, int cells, int faces, double* out, int count) {
+        int width = group.unknowns + 1;
+        int unknowns = group.unknowns;
+        size_t formSize = (size_t)width * lanes;
+        int ring = faces + 1;
+        group.window.assign(ring * formSize, 0.0);
+        group.sum.assign(formSize, 0.0);
+        group.keptForms.assign((size_t)group.kept * formSize, 0.0);
+
+        // Identity rows for padded unknowns; real rows are written when their cell is reached
+        group.matrix.assign((size_t)unknowns * unknowns * lanes, 0.0);
+        group.rhs.assign((size_t)unknowns * lanes, 0.0);
+        for(int j = 0; j < unknowns; j++) {
+            for(int lane = 0; lane < lanes; lane++) group.matrix[((size_t)j * unknowns + j) * lanes + lane] = 1.0;
+        }
+
+        double* sum = group.sum.data();
+        double* window = group.window.data();
+        double* keptForms = group.keptForms.data();
+        double* value = window;
+        int entering = 0;  // ring slot of cell + 1
+        for(int cell = cells; cell >= 0; cell--) {
+            // With faces + 1 slots, this cell's slot still holds cell + faces + 1 (zero past the end).
+            // The value is computed in place over it and is the landing form of every lane without
+            // an entity here. Nonzero coefficients never lie past the width needed below them, so
+            // the slot holds zeros beyond `active` and needs no clearing.
+            int here = cell % ring;
+            int active = group.activeAt[cell];
+            value = window + here * formSize;
+
+            if(cell < cells) {
+                // sum holds the landing forms of cells cell+1 .. cell+faces. Each coefficient row
+                // is worked on in locals so the lane loop vectorizes without alias checks.
+                const double* in = window + entering * formSize;
+                double scale = 1.0 / min(faces, cells - cell);
+                for(int i = 0; i < active; i++) {
+                    double total[lanes], entered[lanes], left[lanes];
+                    memcpy(total, sum + i * lanes, sizeof(total));
+                    memcpy(entered, in + i * lanes, sizeof(entered));
+                    memcpy(left, value + i * lanes, sizeof(left));
+                    for(int lane = 0; lane < lanes; lane++) {
+                        total[lane] += entered[lane] - left[lane];
+                        left[lane] = total[lane] * scale;
+                    }
+                    memcpy(sum + i * lanes, total, sizeof(total));
+                    memcpy(value + i * lanes, left, sizeof(left));
+                }
+                for(int lane = 0; lane < lanes; lane++) value[lane] += faces * scale;
+            }
+            entering = here;
+
+            // Destinations read the value before starts on the same cell overwrite their lanes
+            for(int e = group.eventOffsets[2 * cell]; e < group.eventOffsets[2 * cell + 2]; e++) {
+                const Event& event = group.events[e];
+                int lane = event.lane;
+                if(event.kind == RECORD_ROW) {
+                    // x_slot = value(x)  ->  (I - B) x = a
+                    double* row = &group.matrix[(size_t)event.slot * unknowns * lanes];
+                    for(int i = 0; i < unknowns; i++) row[i * lanes + lane] = (i == event.slot ? 1.0 : 0.0) - value[(i + 1) * lanes + lane];
+                    group.rhs[(size_t)event.slot * lanes + lane] = value[lane];
+                }
+                else if(event.kind == KEEP_FORM) {
+                    double* form = keptForms + event.slot * formSize;
+                    for(int i = 0; i < width; i++) form[i * lanes + lane] = value[i * lanes + lane];
+                }
+                else if(event.kind == LAND_UNKNOWN) {
+                    for(int i = 0; i < width; i++) value[i * lanes + lane] = (i == event.slot + 1) ? 1.0 : 0.0;
+                }
+                else {
+                    const double* form = keptForms + event.slot * formSize;
+                    for(int i = 0; i < width; i++) value[i * lanes + lane] = form[i * lanes + lane];
+                }
+            }
+        }
+
+        // I - B is a nonsingular M-matrix when the board can be finished, so elimination needs no
+        // pivoting and runs on all lanes in step. A lane that hits a zero pivot cannot be finished:
+        // it gets INFINITY, like DifficultyCalibration::expectedTurns, and a unit pivot so the
+        // arithmetic stays finite for the lanes beside it.
+        double* matrix = group.matrix.data();
+        double* rhs = group.rhs.data();
+        bool singular[lanes] = {};
+        for(int col = 0; col < unknowns; col++) {
+            double* pivotRow = matrix + (size_t)col * unknowns * lanes;
+            for(int lane = 0; lane < lanes; lane++) {
+                if(fabs(pivotRow[col * lanes + lane]) < 1e-300) {
+                    singular[lane] = true;
+                    pivotRow[col * lanes + lane] = 1.0;
+                }
+            }
+            for(int row = col + 1; row < unknowns; row++) {
+                double* target = matrix + (size_t)row * unknowns * lanes;
+                double factor[lanes];
+                for(int lane = 0; lane < lanes; lane++) factor[lane] = target[col * lanes + lane] / pivotRow[col * lanes + lane];
+                for(int i = col; i < unknowns; i++) {
+                    for(int lane = 0; lane < lanes; lane++) target[i * lanes + lane] -= factor[lane] * pivotRow[i * lanes + lane];
+                }
+                for(int lane = 0; lane < lanes; lane++) rhs[row * lanes + lane] -= factor[lane] * rhs[col * lanes + lane];
+            }
+        }
+        for(int row = unknowns - 1; row >= 0; row--) {
+            const double* coefficients = matrix + (size_t)row * unknowns * lanes;
+            for(int i = row + 1; i < unknowns; i++) {
+                for(int lane = 0; lane < lanes; lane++) rhs[row * lanes + lane] -= coefficients[i * lanes + lane] * rhs[i * lanes + lane];
+            }
+            for(int lane = 0; lane < lanes; lane++) rhs[row * lanes + lane] /= coefficients[row * lanes + lane];
+        }
+
+        // value holds the start cell's form
+        double result[lanes];
+        for(int lane = 0; lane < lanes; lane++) result[lane] = value[lane];
+        for(int i = 0; i < unknowns; i++) {
+            for(int lane = 0; lane < lanes; lane++) result[lane] += value[(i + 1) * lanes + lane] * rhs[i * lanes + lane];
+        }
+        for(int lane = 0; lane < lanes; lane++) {
+            if(singular[lane]) result[lane] = INFINITY;
+        }
+        memcpy(out, result, count * sizeof(double));
+    }
+
+public:
+    // expectedTurns[b] for boards[b]; every board has `cells` cells and records that
+    // Board::addBoardEntities would accept
+    static vector<double> solve(int cells, const vector<vector<BoardEntityRecord>>& boards, int faces = 6, int threads = 0) {
+        size_t boardCount = boards.size();
+        vector<double> expectedTurns(boardCount, 0.0);
+
+        // Counting sort by snake count (an upper bound on distinct snake destinations)
+        vector<int> snakes(boardCount, 0);
+        int maxSnakes = 0;
+        for(size_t b = 0; b < boardCount; b++) {
+            for(auto& record : boards[b]) snakes[b] += record.isSnake ? 1 : 0;
+            maxSnakes = max(maxSnakes, snakes[b]);
+        }
+        vector<int> offsets(maxSnakes + 2, 0), order(boardCount);
+        for(size_t b = 0; b < boardCount; b++) offsets[snakes[b] + 1]++;
+        for(int k = 0; k <= maxSnakes; k++) offsets[k + 1] += offsets[k];
+        for(size_t b = 0; b < boardCount; b++) order[offsets[snakes[b]]++] = (int)b;
+
+        size_t groupCount = (boardCount + lanes - 1) / lanes;
+        atomic<size_t> nextGroup(0);
+        auto worker = [&]() {
+            Group group;
+            double results[lanes];
+            for(size_t g = nextGroup++; g < groupCount; g = nextGroup++) {
+                int count = (int)min((size_t)lanes, boardCount - g * lanes);
+                const int* members = &order[g * lanes];
+                load(group, cells, boards, members, count);
+                solveGroup(group, cells, faces, results, count);
+                for(int lane = 0; lane < count; lane++) expectedTurns[members[lane]] = results[lane];
+            }
+        };
+        int threadCount = WorkerThreads::resolve(threads);
+        WorkerThreads::run(threadCount, worker);
+        return expectedTurns;
+    }
+};
+
+// Keeps a board's expected turns up to date while its entities are edited one at a time.
+// Only the cells whose rolls changed are rebuilt, and new values spread backwards along
+// reverse edges from a worklist, so an edit costs time in the region whose answer moves.
+// The board's lookup is patched rather than rebuilt, and only entities chained into the
+// edited cells are re-checked, so nothing else in an edit scales with the board.
+class IncrementalAnalyzer {
+private:
+    Board* board;
+    SnakeAndLadderRules* rules;
+    TransitionTable table;
+    vector<double> expected;
+    vector<vector<int>> predecessors;  // states with at least one roll into each state
+    vector<char> inRegion;             // scratch marks, all zero between edits
+    unordered_map<int, vector<int>> startsEndingAt;  // entity end cell -> starts of the entities ending there
+    double tolerance;
+    size_t lastRegionSize;
+    bool valid;
+
+    void addPredecessors(int cell) {
+        int six = table.getSixStates();
+        for(int state = cell * six; state < (cell + 1) * six; state++) {
+            for(int face = 1; face <= table.getFaceCount(); face++) {
+                int target = table.next(state, face);
+                if(target == state) continue;
+                vector<int>& list = predecessors[target];
+                if(find(list.begin(), list.end(), state) == list.end()) list.push_back(state);
+            }
+        }
+    }
+
+    void removePredecessors(int cell) {
+        int six = table.getSixStates();
+        for(int state = cell * six; state < (cell + 1) * six; state++) {
+            for(int face = 1; face <= table.getFaceCount(); face++) {
+                vector<int>& list = predecessors[table.next(state, face)];
+                auto it = find(list.begin(), list.end(), state);
+                if(it != list.end()) list.erase(it);
+            }
+        }
+    }
+
+    void linkEnd(int start, int end) {
+        startsEndingAt[end].push_back(start);
+    }
+
+    void unlinkEnd(int start, int end) {
+        vector<int>& list = startsEndingAt[end];
+        list.erase(find(list.begin(), list.end(), start));
+        if(list.empty()) startsEndingAt.erase(end);
+    }
+
+    bool landsOn(int source, int cell) {
+        for(int face = 1; face <= table.getFaceCount(); face++) {
+            if(rules->getLandingCell(source, face, table.getCellCount()) == cell) return true;
+        }
+        return false;
+    }
+
+    // Rebuilds the rolls that land on any of the touched cells or on a start whose outcome changed,
+    // and re-solves the states that can reach them. The rules must already be bound to the edited board.
+    void refresh(vector<int> touched, const vector<int>& candidates, const vector<int>& before) {
+        vector<int> after = outcomesAt(board, rules, candidates);
+        for(size_t i = 0; i < candidates.size(); i++) {
+            if(after[i] != before[i]) touched.push_back(candidates[i]);
+        }
+
+        // Sources whose roll lands on a touched cell: the cells just below it, and the last few
+        // cells for rules that bounce back off the end
+        int cells = table.getCellCount();
+        int faces = table.getFaceCount();
+        vector<int> rows;
+        for(int cell : touched) {
+            for(int source = max(0, cell - faces); source < cell; source++) {
+                if(landsOn(source, cell)) rows.push_back(source);
+            }
+            for(int source = max(cell, cells - faces); source < cells; source++) {
+                if(landsOn(source, cell)) rows.push_back(source);
+            }
+        }
+        sort(rows.begin(), rows.end());
+        rows.erase(unique(rows.begin(), rows.end()), rows.end());
+
+        vector<int> region;
+        int six = table.getSixStates();
+        for(int cell : rows) {
+            removePredecessors(cell);
+            table.rebuildCell(board, rules, cell);
+            addPredecessors(cell);
+            for(int state = cell * six; state < (cell + 1) * six; state++) {
+                if(!inRegion[state]) {
+                    inRegion[state] = 1;
+                    region.push_back(state);
+                }
+            }
+        }
+
+        // Only states that can reach a changed row can change value
+        for(size_t i = 0; i < region.size(); i++) {
+            for(int source : predecessors[region[i]]) {
+                if(!inRegion[source]) {
+                    inRegion[source] = 1;
+                    region.push_back(source);
+                }
+            }
+        }
+        for(int state : region) {
+            inRegion[state] = 0;
+        }
+
+        // Re-solve the region from the old values, in the solver's descending order
+        sort(region.begin(), region.end(), greater<int>());
+        lastRegionSize = region.size();
+        BoardAnalyzer::sweepStates(table, expected, region, tolerance);
+    }
+
+public:
+    // Starts whose landing outcome can depend on the entities at these cells: the cells themselves
+    // and every entity whose end leads into them, directly or through a chain. Outcomes elsewhere
+    // cannot change with an edit there, so only these need comparing before and after it.
+    static vector<int> chainedInto(const unordered_map<int, vector<int>>& startsEndingAt, const vector<int>& cells) {
+        vector<int> starts(cells);
+        unordered_set<int> seen(cells.begin(), cells.end());
+        for(size_t i = 0; i < starts.size(); i++) {
+            auto feeding = startsEndingAt.find(starts[i]);
+            if(feeding == startsEndingAt.end()) continue;
+            for(int start : feeding->second) {
+                if(seen.insert(start).second) starts.push_back(start);
+            }
+        }
+        return starts;
+    }
+
+    // Where landing on each of these cells leads; the rules must be bound to board
+    static vector<int> outcomesAt(Board* board, SnakeAndLadderRules* rules, const vector<int>& starts) {
+        vector<int> outcomes(starts.size());
+        int cells = board->getBoardSize();
+        for(size_t i = 0; i < starts.size(); i++) {
+            int start = starts[i];
+            outcomes[i] = rules->isValidMove(start - 1, 1, cells) ? rules->calculateNewPosition(start - 1, 1, board) : start;
+        }
+        return outcomes;
+    }
+
+    IncrementalAnalyzer(Board* b, SnakeAndLadderRules* r, const DiceDistribution& dice, double tol = 1e-12)
+        : board(b), rules(r), table(b, r, dice), tolerance(tol), lastRegionSize(0) {
+        valid = BoardAnalyzer::solveExpectedTurns(table, expected, tol);
+        if(!valid) {
+            expected.assign(table.getStateCount(), INFINITY);
+        }
+        predecessors.assign(table.getStateCount(), vector<int>());
+        inRegion.assign(table.getStateCount(), 0);
+        for(int cell = 0; cell < table.getCellCount(); cell++) {
+            addPredecessors(cell);
+        }
+        for(auto entity : board->getEntities()) {
+            linkEnd(entity->getStart(), entity->getEnd());
+        }
+    }
+
+    // Same geometry rules as the Snake and Ladder constructors
+    bool addEntity(int start, int end) {
+        if(!valid) {
+            return false;
+        }
+        int cells = board->getBoardSize();
+        if(start == end || start < 1 || start >= cells || end < 1 || end > cells || !board->canAddEntity(start)) {
+            cout << "Cannot place an entity from " << start << " to " << end << "." << endl;
+            return false;
+        }
+        vector<int> candidates = chainedInto(startsEndingAt, vector<int>(1, start));
+        vector<int> before = outcomesAt(board, rules, candidates);
+        vector<BoardEntityRecord> record(1, BoardEntityRecord{start, end, end < start});
+        if(!board->addBoardEntities(record)) {
+            return false;
+        }
+        if(!rules->bindBoard(board)) {
+            cout << "The entity from " << start << " to " << end << " is rejected by the rules; it is not added." << endl;
+            board->removeBoardEntity(start);
+            rules->bindBoard(board);
+            return false;
+        }
+        linkEnd(start, end);
+        refresh(vector<int>(1, start), candidates, before);
+        return true;
+    }
+
+    bool removeEntity(int start) {
+        if(!valid) {
+            return false;
+        }
+        BoardEntity* entity = board->getEntity(start);
+        if(entity == nullptr) {
+            cout << "No entity starts at cell " << start << "." << endl;
+            return false;
+        }
+        vector<int> candidates = chainedInto(startsEndingAt, vector<int>(1, start));
+        vector<int> before = outcomesAt(board, rules, candidates);
+        unlinkEnd(start, entity->getEnd());
+        board->removeBoardEntity(start);
+        rules->bindBoard(board);  // removing an entity cannot close a cycle
+        refresh(vector<int>(1, start), candidates, before);
+        return true;
+    }
+
+    bool moveEntity(int start, int newStart, int newEnd) {
+        if(!valid) {
+            return false;
+        }
+        BoardEntity* entity = board->getEntity(start);
+        if(entity == nullptr) {
+            cout << "No entity starts at cell " << start << "." << endl;
+            return false;
+        }
+        int oldEnd = entity->getEnd();
+        vector<int> touched;
+        touched.push_back(start);
+        touched.push_back(newStart);
+        vector<int> candidates = chainedInto(startsEndingAt, touched);
+        vector<int> before = outcomesAt(board, rules, candidates);
+        board->removeBoardEntity(start);
+
+        int cells = board->getBoardSize();
+        bool allowed = newStart != newEnd && newStart >= 1 && newStart < cells && newEnd >= 1 && newEnd <= cells
+            && board->canAddEntity(newStart);
+        vector<BoardEntityRecord> record(1, BoardEntityRecord{newStart, newEnd, newEnd < newStart});
+        bool placed = allowed && board->addBoardEntities(record);
+        if(placed && !rules->bindBoard(board)) {
+            board->removeBoardEntity(newStart);
+            placed = false;
+        }
+        if(!placed) {
+            cout << "Cannot move the entity to " << newStart << " -> " << newEnd << "; it stays in place." << endl;
+            record[0] = BoardEntityRecord{start, oldEnd, oldEnd < start};
+            board->addBoardEntities(record);
+            rules->bindBoard(board);
+            return false;
+        }
+        unlinkEnd(start, oldEnd);
+        linkEnd(newStart, newEnd);
+        refresh(touched, candidates, before);
+        return true;
+    }
+
+    // False when the rules rejected the starting board; no edits are accepted then
+    bool isValid() {
+        return valid;
+    }
+
+    double expectedTurnsFromStart() {
+        return expected[table.stateOf(0)];
+    }
+
+    const vector<double>& getExpectedTurns() {
+        return expected;
+    }
+
+    TransitionTable& getTable() {
+        return table;
+    }
+
+    // States the last edit could affect (the ones that were re-solved)
+    size_t getLastRegionSize() {
+        return lastRegionSize;
+    }
+};
+
+// Aggregate results of headless multi-player games
+struct SimulationStats {
+    int games;
+    double meanTurns;     // turns taken by the winner (rounds)
+    double stdDevTurns;
+    vector<double> seatWinRates;
+};
+
+// Monte Carlo simulator mirroring SnakeAndLadderGame::play() without console I/O
+class GameSimulator {
+public:
+    static SimulationStats simulate(TransitionTable& table, int players, int games, uint64_t seed) {
+        RollBuffer dice(table.getDice(), seed);
+
+        SimulationStats stats;
+        stats.games = games;
+        stats.seatWinRates.assign(players, 0.0);
+
+        vector<int> states(players);
+        double sum = 0.0, sumSquares = 0.0;
+
+        for(int game = 0; game < games; game++) {
+            fill(states.begin(), states.end(), 0);
+            int winnerSeat = -1;
+            int round = 0;
+
+            while(winnerSeat < 0 && round < 10000000) {
+                round++;
+                for(int seat = 0; seat < players && winnerSeat < 0; seat++) {
+                    // A turn may take several rolls when the rules grant extra ones
+                    for(int roll = 0; roll < 1000; roll++) {
+                        int face = dice.next();
+                        bool turnOver = table.endsTurn(states[seat], face);
+                        states[seat] = table.next(states[seat], face);
+                        if(table.isFinished(states[seat])) {
+                            winnerSeat = seat;
+                            break;
+                        }
+                        if(turnOver) break;
+                    }
+                }
+            }
+
+            if(winnerSeat >= 0) {
+                stats.seatWinRates[winnerSeat] += 1.0;
+            }
+            sum += round;
+            sumSquares += (double)round * round;
+        }
+
+        if(games > 0) {
+            stats.meanTurns = sum / games;
+            stats.stdDevTurns = sqrt(max(0.0, sumSquares / games - stats.meanTurns * stats.meanTurns));
+            for(auto& rate : stats.seatWinRates) {
+                rate /= games;
+            }
+        }
+        else {
+            stats.meanTurns = 0.0;
+            stats.stdDevTurns = 0.0;
+        }
+        return stats;
+    }
+};
+
+// Probability that a single player finishes on each turn
+struct GameLengthDistribution {
+    vector<double> finishedAt;  // finishedAt[t] = P(finish exactly on turn t); index 0 is always 0
+    double unfinishedMass;      // mass still on the board when propagation stopped
+
+    // P(finished by turn t)
+    double cumulative(int turn) {
+        double total = 0.0;
+        for(int t = 1; t <= turn && t < (int)finishedAt.size(); t++) {
+            total += finishedAt[t];
+        }
+        return total;
+    }
+
+    // Smallest turn t with P(finished by t) >= q
+    int percentile(double q) {
+        double total = 0.0;
+        for(int t = 1; t < (int)finishedAt.size(); t++) {
+            total += finishedAt[t];
+            if(total >= q) return t;
+        }
+        return (int)finishedAt.size();
+    }
+
+    double mean() {
+        double total = 0.0;
+        for(int t = 1; t < (int)finishedAt.size(); t++) {
+            total += t * finishedAt[t];
+        }
+        return total;
+    }
+};
+
+// Exact game-length distribution by pushing the position probability vector through the
+// transition table one turn at a time, collecting the mass that reaches the final cell.
+class GameLengthAnalyzer {
+private:
+    // Roll whose destination is not simply source + face and cannot be described by the
+    // landing cell alone (blocked or bounced moves near the end)
+    struct Exception {
+        int source;
+        int face;
+        int destination;
+    };
+
+    // Landing on cell moves the mass on to destination (snake or ladder)
+    struct Redirect {
+        int cell;
+        int destination;
+    };
+
+    static const int stencilBlock = 2048;
+    static const int tailWindow = 32;
+
+    // Once only the slowest-decaying mode is left, every turn finishes the same fraction
+    // of the remaining mass, so the rest of the distribution is a geometric series.
+    // True when the last tailWindow ratios agree and account for all remaining mass.
+    static bool geometricTail(const vector<double>& finishedAt, double remaining, double& ratio) {
+        size_t n = finishedAt.size();
+        if(n < (size_t)tailWindow + 3 || finishedAt[n - 2] <= 0.0) return false;
+
+        ratio = finishedAt[n - 1] / finishedAt[n - 2];
+        if(!(ratio > 0.0 && ratio < 1.0)) return false;
+        for(int k = 1; k <= tailWindow; k++) {
+            double earlier = finishedAt[n - 1 - k] / finishedAt[n - 2 - k];
+            if(fabs(earlier - ratio) > 1e-12 * ratio) return false;
+        }
+
+        double predicted = finishedAt[n - 1] * ratio / (1.0 - ratio);
+        return fabs(predicted - remaining) <= 1e-6 * remaining;
+    }
+
+    static void closeGeometricTail(GameLengthDistribution& result, double remaining, double ratio, double epsilon, int maxTurns) {
+        while(remaining > epsilon && (int)result.finishedAt.size() <= maxTurns) {
+            double finished = result.finishedAt.back() * ratio;
+            result.finishedAt.push_back(finished);
+            remaining -= finished;
+        }
+        result.unfinishedMass = max(0.0, remaining);
+    }
+
+    // Plain tables (one state per cell, every roll ends the turn) move mass with a
+    // faces-wide stencil over the active range, one streaming pass the compiler vectorizes.
+    // Snakes and ladders are then applied per landing cell, and the few rolls that depend
+    // on where they started are corrected from a sorted exception list.
+    static void propagateShifted(TransitionTable& table, GameLengthDistribution& result, double epsilon, int maxTurns) {
+        int cells = table.getCellCount();
+        int faces = table.getFaceCount();
+
+        vector<double> probability(faces + 1, 0.0);
+        for(int face = 1; face <= faces; face++) {
+            probability[face] = table.faceProbability(face);
+        }
+
+        // A raw landing cell is regular when every roll onto it ends in the same place
+        vector<int> landing(cells + 1, -1);
+        vector<char> irregular(cells + 1, 0);
+        for(int cell = 0; cell < cells; cell++) {
+            for(int face = 1; face <= faces && cell + face <= cells; face++) {
+                if(probability[face] == 0.0) continue;
+                int raw = cell + face;
+                int destination = table.next(cell, face);
+                if(landing[raw] < 0) landing[raw] = destination;
+                else if(landing[raw] != destination) irregular[raw] = 1;
+            }
+        }
+
+        vector<Redirect> redirects;
+        for(int cell = 1; cell <= cells; cell++) {
+            if(!irregular[cell] && landing[cell] >= 0 && landing[cell] != cell) {
+                redirects.push_back({cell, landing[cell]});
+            }
+        }
+        vector<Exception> exceptions;
+        for(int cell = 0; cell < cells; cell++) {
+            for(int face = 1; face <= faces; face++) {
+                if(probability[face] == 0.0) continue;
+                int raw = cell + face;
+                int destination = table.next(cell, face);
+                if(raw > cells || irregular[raw]) {
+                    if(destination != raw) exceptions.push_back({cell, face, destination});
+                }
+            }
+        }
+
+        // Cell c lives at index c + faces so the stencil never reads before the start;
+        // the tail padding catches overshooting rolls until they are corrected
+        int pad = faces;
+        vector<double> current(cells + 2 * faces + 1, 0.0), upcoming(cells + 2 * faces + 1, 0.0);
+        vector<double> moved;
+        double* cur = current.data() + pad;
+        double* up = upcoming.data() + pad;
+        cur[0] = 1.0;
+        int low = 0, high = 0;
+        double remaining = 1.0;
+
+        for(int turn = 1; turn <= maxTurns && remaining > epsilon; turn++) {
+            int newLow = low + 1, newHigh = high + faces;
+
+            // Blocked so each face's pass over a block hits L1; the inner loop is contiguous
+            for(int blockStart = newLow; blockStart <= newHigh; blockStart += stencilBlock) {
+                int blockEnd = min(newHigh + 1, blockStart + stencilBlock);
+                fill(up + blockStart, up + blockEnd, 0.0);
+                for(int face = 1; face <= faces; face++) {
+                    double p = probability[face];
+                    if(p == 0.0) continue;
+                    const double* from = cur + blockStart - face;
+                    double* to = up + blockStart;
+                    int span = blockEnd - blockStart;
+                    for(int i = 0; i < span; i++) {
+                        to[i] += p * from[i];
+                    }
+                }
+            }
+
+            // Gather first so mass moved onto another entity's start is not moved twice
+            auto first = lower_bound(redirects.begin(), redirects.end(), low + 1,
+                                     [](const Redirect& r, int cell) { return r.cell < cell; });
+            auto last = first;
+            moved.clear();
+            for(; last != redirects.end() && last->cell <= high + faces; ++last) {
+                moved.push_back(up[last->cell]);
+                up[last->cell] = 0.0;
+            }
+            for(size_t i = 0; i < moved.size(); i++) {
+                int destination = first[i].destination;
+                up[destination] += moved[i];
+                newLow = min(newLow, destination);
+                newHigh = max(newHigh, destination);
+            }
+
+            // Exception rolls go last: their destination already includes any snake or ladder,
+            // and their raw cell is never a redirect, so nothing above may move them again
+            auto ex = lower_bound(exceptions.begin(), exceptions.end(), low,
+                                  [](const Exception& e, int cell) { return e.source < cell; });
+            for(; ex != exceptions.end() && ex->source <= high; ++ex) {
+                double mass = probability[ex->face] * cur[ex->source];
+                up[ex->source + ex->face] -= mass;
+                up[ex->destination] += mass;
+                newLow = min(newLow, ex->destination);
+            }
+
+            double finished = up[cells];
+            for(int cell = cells; cell <= cells + faces; cell++) {
+                up[cell] = 0.0;
+            }
+            result.finishedAt.push_back(finished);
+            remaining -= finished;
+
+            // The old range is cleared so the buffers can swap with everything outside zero
+            fill(cur + low, cur + high + 1, 0.0);
+            swap(current, upcoming);
+            swap(cur, up);
+            low = newLow;
+            high = min(newHigh, cells - 1);
+            while(low < high && cur[low] == 0.0) low++;
+            while(high > low && cur[high] == 0.0) high--;
+
+            double ratio;
+            if(geometricTail(result.finishedAt, remaining, ratio)) {
+                closeGeometricTail(result, remaining, ratio, epsilon, maxTurns);
+                return;
+            }
+        }
+        result.unfinishedMass = max(0.0, remaining);
+    }
+
+    // Any table: scatter every state's mass along its rolls. Rolls that earn another roll
+    // feed a sub-step inside the same turn until the extra-roll mass dies out.
+    static void propagateScattered(TransitionTable& table, GameLengthDistribution& result, double epsilon, int maxTurns) {
+        int states = table.getStateCount();
+        int faces = table.getFaceCount();
+        vector<double> probability(faces + 1, 0.0);
+        for(int face = 1; face <= faces; face++) {
+            probability[face] = table.faceProbability(face);
+        }
+
+        vector<double> current(states, 0.0), upcoming(states, 0.0), rolling(states, 0.0), rollingNext(states, 0.0);
+        current[table.stateOf(0)] = 1.0;
+        double remaining = 1.0;
+
+        for(int turn = 1; turn <= maxTurns && remaining > epsilon; turn++) {
+            double finished = 0.0;
+            swap(rolling, current);
+            double rollingMass = remaining;
+
+            for(int subStep = 0; subStep < 1000 && rollingMass > epsilon * 1e-3; subStep++) {
+                rollingMass = 0.0;
+                for(int state = 0; state < states; state++) {
+                    double mass = rolling[state];
+                    if(mass == 0.0) continue;
+                    rolling[state] = 0.0;
+                    for(int face = 1; face <= faces; face++) {
+                        double p = probability[face];
+                        if(p == 0.0) continue;
+                        int target = table.next(state, face);
+                        double moved = p * mass;
+                        if(table.isFinished(target)) {
+                            finished += moved;
+                        }
+                        else if(table.endsTurn(state, face)) {
+                            upcoming[target] += moved;
+                        }
+                        else {
+                            rollingNext[target] += moved;
+                            rollingMass += moved;
+                        }
+                    }
+                }
+                swap(rolling, rollingNext);
+            }
+            // Whatever is still mid-turn after the cap is carried into the next turn
+            for(int state = 0; state < states; state++) {
+                upcoming[state] += rolling[state];
+                rolling[state] = 0.0;
+            }
+
+            result.finishedAt.push_back(finished);
+            remaining -= finished;
+            swap(current, upcoming);
+
+            double ratio;
+            if(geometricTail(result.finishedAt, remaining, ratio)) {
+                closeGeometricTail(result, remaining, ratio, epsilon, maxTurns);
+                return;
+            }
+        }
+        result.unfinishedMass = max(0.0, remaining);
+    }
+
+public:
+    // Stops once less than epsilon of the probability is still on the board
+    static GameLengthDistribution singlePlayer(TransitionTable& table, double epsilon = 1e-12, int maxTurns = 10000000) {
+        GameLengthDistribution result;
+        result.finishedAt.push_back(0.0);
+
+        bool plain = (table.getSixStates() == 1);
+        for(int state = 0; plain && state < table.getStateCount(); state++) {
+            for(int face = 1; face <= table.getFaceCount(); face++) {
+                if(!table.endsTurn(state, face)) {
+                    plain = false;
+                    break;
+                }
+            }
+        }
+
+        if(plain) {
+            propagateShifted(table, result, epsilon, maxTurns);
+        }
+        else {
+            propagateScattered(table, result, epsilon, maxTurns);
+        }
+        return result;
+    }
+};
+
+// Exact outcome of a P-player game where every player follows the same single-player law
+struct MultiPlayerOutcome {
+    vector<double> seatWinProbability;  // seat 0 moves first
+    vector<double> endsAtRound;         // endsAtRound[t] = P(someone wins in round t)
+    double meanRounds;
+    double unresolvedMass;              // left over from the truncated single-player tail
+};
+
+// Players never interact, so the winner is the first seat in turn order to reach its own
+// finishing turn T. Seat k wins in round t when T_k = t, every earlier seat has T > t and
+// every later seat has T > t - 1:  P(k) = sum_t f(t) S(t)^k S(t-1)^(P-1-k), S(t) = P(T > t)
+class MultiPlayerAnalyzer {
+public:
+    // One O(T * P) pass over the single-player distribution
+    static MultiPlayerOutcome analyze(GameLengthDistribution& single, int players) {
+        MultiPlayerOutcome outcome;
+        outcome.seatWinProbability.assign(max(players, 0), 0.0);
+        outcome.endsAtRound.assign(single.finishedAt.size(), 0.0);
+        outcome.meanRounds = 0.0;
+        outcome.unresolvedMass = 1.0;
+        if(players < 1) {
+            return outcome;
+        }
+
+        double survivedBefore = 1.0;  // S(t - 1)
+        for(size_t t = 1; t < single.finishedAt.size(); t++) {
+            double f = single.finishedAt[t];
+            double survived = max(0.0, survivedBefore - f);  // S(t)
+
+            if(f > 0.0) {
+                // term_k = f * S(t)^k * S(t-1)^(P-1-k), walked from k = 0 by the ratio S(t) / S(t-1)
+                double term = f * pow(survivedBefore, players - 1);
+                double ratio = survived / survivedBefore;
+                double roundTotal = 0.0;
+                for(int seat = 0; seat < players && term > 0.0; seat++) {
+                    outcome.seatWinProbability[seat] += term;
+                    roundTotal += term;
+                    term *= ratio;
+                }
+                outcome.endsAtRound[t] = roundTotal;
+                outcome.meanRounds += t * roundTotal;
+                outcome.unresolvedMass -= roundTotal;
+            }
+            survivedBefore = survived;
+        }
+        outcome.unresolvedMass = max(0.0, outcome.unresolvedMass);
+        return outcome;
+    }
+};
+
+// Fast-path simulator for rules where players never interact: each player's finishing turn
+// is drawn from the exact single-player distribution (alias table), and the winner is the
+// lowest finishing turn, ties going to the earlier seat. O(P) per game instead of O(P * turns).
+class DecompositionSimulator {
+public:
+    static SimulationStats simulate(Board* board, SnakeAndLadderRules* rules, const DiceDistribution& dice,
+                                    int players, int games, uint64_t seed) {
+        TransitionTable table(board, rules, dice);
+        if(rules->playersInteract()) {
+            return GameSimulator::simulate(table, players, games, seed);
+        }
+
+        GameLengthDistribution single = GameLengthAnalyzer::singlePlayer(table);
+        if(single.finishedAt.size() < 2 || single.unfinishedMass > 1e-6) {
+            // The finishing turn is not well described (unreachable end or a very long tail)
+            return GameSimulator::simulate(table, players, games, seed);
+        }
+        
+        // Turns 1..T as the values of a discrete distribution; the truncated tail is dropped
+        DiceDistribution finishingTurn(vector<double>(single.finishedAt.begin() + 1, single.finishedAt.end()));
+        FastRandom rng(seed);
+
+        SimulationStats stats;
+        stats.games = games;
+        stats.seatWinRates.assign(players, 0.0);
+        double sum = 0.0, sumSquares = 0.0;
+
+        for(int game = 0; game < games; game++) {
+            int bestTurn = INT32_MAX;
+            int winnerSeat = 0;
+            for(int seat = 0; seat < players; seat++) {
+                int turn = finishingTurn.sampleFrom(rng.next());
+                if(turn < bestTurn) {
+                    bestTurn = turn;
+                    winnerSeat = seat;
+                }
+            }
+            stats.seatWinRates[winnerSeat] += 1.0;
+            sum += bestTurn;
+            sumSquares += (double)bestTurn * bestTurn;
+        }
+
+        if(games > 0) {
+            stats.meanTurns = sum / games;
+            stats.stdDevTurns = sqrt(max(0.0, sumSquares / games - stats.meanTurns * stats.meanTurns));
+            for(auto& rate : stats.seatWinRates) {
+                rate /= games;
+            }
+        }
+        else {
+            stats.meanTurns = 0.0;
+            stats.stdDevTurns = 0.0;
+        }
+        return stats;
+    }
+
+    static SimulationStats simulate(Board* board, SnakeAndLadderRules* rules, int faces, int players, int games, uint64_t seed) {
+        return simulate(board, rules, DiceDistribution::fair(faces), players, games, seed);
+    }
+};
+
+// Expected traffic of one player's game, per cell and per entity
+struct EntityHits {
+    int start;
+    int end;
+    bool isSnake;
+    double hitsPerGame;   // expected number of times the entity is taken
+};
+
+struct VisitHeatmap {
+    vector<double> landings;      // per cell: expected rolls per game landing on it, before any snake or ladder
+    vector<double> occupancy;     // per cell: expected rolls per game made from it
+    vector<EntityHits> entities;  // in board->getEntities() order
+    double expectedRolls = 0.0;
+};
+
+// Exact per-cell visit frequencies and per-entity hit counts. The expected visits to every
+// state from the start are the start row of the fundamental matrix (I - Q)^-1, found with the
+// same forward sweeps as the expected turns, so the cost matches one expected-length solve.
+// Landings and entity hits then follow from one pass over the rolls out of each state.
+class VisitAnalyzer {
+public:
+    // Expected number of visits to every state, starting from the start state:
+    // v[t] = [t == start] + sum over rolls s -> t of v[s] * p
+    static bool solveVisits(TransitionTable& table, vector<double>& visits) {
+        int states = table.getStateCount();
+        int faces = table.getFaceCount();
+        int finished = table.stateOf(table.getCellCount());
+        int start = table.stateOf(0);
+
+        // Reverse edges in CSR form; rolls that stay put are folded into the denominator
+        vector<int> offsets(states + 1, 0);
+        vector<double> stay(states, 0.0);
+        for(int state = 0; state < finished; state++) {
+            for(int face = 1; face <= faces; face++) {
+                int target = table.next(state, face);
+                if(table.faceProbability(face) > 0.0 && target != state && target < finished) offsets[target + 1]++;
+            }
+        }
+        for(int state = 0; state < states; state++) {
+            offsets[state + 1] += offsets[state];
+        }
+        vector<int> sources(offsets[states]);
+        vector<double> weights(offsets[states]);
+        vector<int> fillAt(offsets.begin(), offsets.end() - 1);
+        for(int state = 0; state < finished; state++) {
+            for(int face = 1; face <= faces; face++) {
+                double p = table.faceProbability(face);
+                int target = table.next(state, face);
+                if(p == 0.0) continue;
+                if(target == state) {
+                    stay[state] += p;
+                }
+                else if(target < finished) {
+                    sources[fillAt[target]] = state;
+                    weights[fillAt[target]] = p;
+                    fillAt[target]++;
+                }
+            }
+        }
+
+        // Visits flow forwards, so the sweep runs from the start upwards
+        vector<int> order(finished);
+        for(int i = 0; i < finished; i++) {
+            order[i] = i;
+        }
+        visits.assign(states, 0.0);
+        auto update = [&](int state) {
+            double sum = (state == start) ? 1.0 : 0.0;
+            for(int i = offsets[state]; i < offsets[state + 1]; i++) {
+                sum += visits[sources[i]] * weights[i];
+            }
+            return sum / (1.0 - stay[state]);
+        };
+        if(!BoardAnalyzer::iterate(visits, order, update, start, 1e-12)) {
+            cout << "Visit counts did not converge; the final cell may be unreachable." << endl;
+            return false;
+        }
+        return true;
+    }
+
+    static bool analyze(Board* board, SnakeAndLadderRules* rules, const DiceDistribution& dice, VisitHeatmap& heatmap) {
+        TransitionTable table(board, rules, dice);
+        vector<double> visits;
+        if(!solveVisits(table, visits)) {
+            return false;
+        }
+
+        int cells = table.getCellCount();
+        int faces = table.getFaceCount();
+        int six = table.getSixStates();
+        int forfeitCount = rules->getForfeitSixCount();
+        vector<BoardEntity*>& entities = board->getEntities();
+        vector<int> entityAt(cells + 1, -1);
+        heatmap.entities.clear();
+        for(size_t i = 0; i < entities.size(); i++) {
+            entityAt[entities[i]->getStart()] = (int)i;
+            heatmap.entities.push_back(EntityHits{entities[i]->getStart(), entities[i]->getEnd(),
+                                                  entities[i]->getEnd() < entities[i]->getStart(), 0.0});
+        }
+        heatmap.landings.assign(cells + 1, 0.0);
+        heatmap.occupancy.assign(cells + 1, 0.0);
+        heatmap.expectedRolls = 0.0;
+
+        for(int cell = 0; cell < cells; cell++) {
+            for(int sixes = 0; sixes < six; sixes++) {
+                int state = cell * six + sixes;
+                heatmap.occupancy[cell] += visits[state];
+                heatmap.expectedRolls += visits[state];
+                for(int face = 1; face <= faces; face++) {
+                    double flow = visits[state] * table.faceProbability(face);
+                    if(flow == 0.0 || !rules->isValidMove(cell, face, cells)) continue;
+                    if(face == 6 && forfeitCount > 0 && sixes + 1 >= forfeitCount) continue;  // move forfeited
+                    int landing = rules->getLandingCell(cell, face, cells);
+                    heatmap.landings[landing] += flow;
+
+                    // Every entity on the way from the landing cell to where the roll ends is taken;
+                    // more than one only when the rules follow chains
+                    int target = table.cellOf(table.next(state, face));
+                    for(int at = landing, taken = 0; at != target && entityAt[at] >= 0 && taken < (int)entities.size(); taken++) {
+                        heatmap.entities[entityAt[at]].hitsPerGame += flow;
+                        at = heatmap.entities[entityAt[at]].end;
+                    }
+                }
+            }
+        }
+        return true;
+    }
+};
+
+// Rolls of a TransitionTable grouped by the cell they land on before any entity applies (CSR by
+// landing cell), plus the table's reverse edges. Sending the rolls that land on a few cells
+// somewhere else is a low-rank change of the transition matrix, so its effect on the expected
+// turns follows exactly from one landing-count solve per column and a small dense solve (Woodbury):
+//     E' = E + L (d + z),   (I - D^T L) z = D^T (E + L d)
+// Column h of L holds the expected landings of one class of rolls from each state, D sends each
+// class from its current target to its new one, and d is the change in turn-ending for classes
+// whose rolls earn another roll unless they win. A class is the rolls onto one cell that arrive
+// with the same six count and extra-turn flag; they all go to one state before and after.
+class LandingRedirects {
+public:
+    struct Column {
+        int cell;
+        int group;          // six count the rolls arrive with
+        bool extraTurn;     // the rolls earn another roll unless they finish the game
+        int target;         // state the rolls go to now
+        int destination;    // cell to send them to; starts as the cell they reach now
+        size_t slot;        // landing counts in Workspace::counts
+        size_t region;      // states with nonzero counts, in Workspace::regions
+    };
+
+    // Per-thread scratch. Count arrays are reused between cells and cleared over their region only.
+    struct Workspace {
+        vector<Column> columns;
+        vector<vector<double>> counts;
+        vector<vector<int>> regions;
+        size_t regionCount = 0;
+        vector<double> inflow;
+        vector<char> inRegion;
+        vector<double> matrix, rhs, turnChange;
+    };
+
+private:
+    TransitionTable& table;
+    int cells;
+    int faces;
+    int six;
+    int states;
+    int finished;
+    int startState;
+    vector<int> flowOffsets, flowState, flowTarget, flowClass;
+    vector<double> flowProbability;
+    vector<int> predecessorOffsets, predecessors;
+
+    int stateAt(int cell, int group) {
+        return cell == cells ? finished : cell * six + group;
+    }
+
+public:
+    LandingRedirects(TransitionTable& t, SnakeAndLadderRules* rules) : table(t) {
+        cells = table.getCellCount();
+        faces = table.getFaceCount();
+        six = table.getSixStates();
+        states = table.getStateCount();
+        finished = table.stateOf(cells);
+        startState = table.stateOf(0);
+        int forfeitCount = rules->getForfeitSixCount();
+
+        flowOffsets.assign(cells + 1, 0);
+        predecessorOffsets.assign(states + 1, 0);
+        for(int pass = 0; pass < 2; pass++) {
+            vector<int> flowFill(flowOffsets.begin(), flowOffsets.end() - 1);
+            vector<int> predecessorFill(predecessorOffsets.begin(), predecessorOffsets.end() - 1);
+            for(int state = 0; state < finished; state++) {
+                int cell = table.cellOf(state);
+                int sixes = state - cell * six;
+                for(int face = 1; face <= faces; face++) {
+                    double p = table.faceProbability(face);
+                    int target = table.next(state, face);
+                    if(p == 0.0) continue;
+                    if(target != state && target < finished) {
+                        if(pass == 0) predecessorOffsets[target + 1]++;
+                        else predecessors[predecessorFill[target]++] = state;
+                    }
+                    if(!rules->isValidMove(cell, face, cells)) continue;
+                    if(face == 6 && forfeitCount > 0 && sixes + 1 >= forfeitCount) continue;  // move forfeited
+                    int landing = rules->getLandingCell(cell, face, cells);
+                    if(landing < 1 || landing >= cells) continue;
+                    if(pass == 0) {
+                        flowOffsets[landing + 1]++;
+                        continue;
+                    }
+                    int group = (face == 6 && forfeitCount > 0) ? sixes + 1 : 0;
+                    int at = flowFill[landing]++;
+                    flowState[at] = state;
+                    flowTarget[at] = target;
+                    flowClass[at] = group * 2 + (rules->grantsExtraTurn(face) ? 1 : 0);
+                    flowProbability[at] = p;
+                }
+            }
+            if(pass == 0) {
+                for(int cell = 0; cell < cells; cell++) flowOffsets[cell + 1] += flowOffsets[cell];
+                for(int state = 0; state < states; state++) predecessorOffsets[state + 1] += predecessorOffsets[state];
+                flowState.resize(flowOffsets[cells]);
+                flowTarget.resize(flowOffsets[cells]);
+                flowClass.resize(flowOffsets[cells]);
+                flowProbability.resize(flowOffsets[cells]);
+                predecessors.resize(predecessorOffsets[states]);
+            }
+        }
+    }
+
+    bool hasLandings(int cell) {
+        return cell >= 1 && cell < cells && flowOffsets[cell] != flowOffsets[cell + 1];
+    }
+
+    // Adds a column per class of rolls landing on cell, each solved over the states that can reach
+    // those rolls. With skipUnreachable, a cell the game
+    // never lands on from the start adds nothing: redirecting only its rolls cannot change the
+    // answer. False when the sweeps did not converge.
+    bool addColumns(Workspace& w, int cell, bool skipUnreachable = false) {
+        if(!hasLandings(cell)) return true;
+        if(w.inRegion.empty()) {
+            w.inRegion.assign(states, 0);
+            w.inflow.assign(states, 0.0);
+        }
+
+        // Only states that can reach a roll onto cell have nonzero landing counts
+        if(w.regionCount == w.regions.size()) w.regions.emplace_back();
+        vector<int>& region = w.regions[w.regionCount];
+        region.clear();
+        for(int i = flowOffsets[cell]; i < flowOffsets[cell + 1]; i++) {
+            if(!w.inRegion[flowState[i]]) {
+                w.inRegion[flowState[i]] = 1;
+                region.push_back(flowState[i]);
+            }
+        }
+        for(size_t i = 0; i < region.size(); i++) {
+            for(int j = predecessorOffsets[region[i]]; j < predecessorOffsets[region[i] + 1]; j++) {
+                if(!w.inRegion[predecessors[j]]) {
+                    w.inRegion[predecessors[j]] = 1;
+                    region.push_back(predecessors[j]);
+                }
+            }
+        }
+        bool reachable = w.inRegion[startState] != 0;
+        for(int state : region) w.inRegion[state] = 0;
+        if(skipUnreachable && !reachable) return true;
+        sort(region.begin(), region.end(), greater<int>());
+        size_t regionIndex = w.regionCount++;
+
+        for(int flowKind = 0; flowKind < 2 * six; flowKind++) {
+            int firstFlow = -1;
+            for(int i = flowOffsets[cell]; i < flowOffsets[cell + 1]; i++) {
+                if(flowClass[i] == flowKind) {
+                    w.inflow[flowState[i]] += flowProbability[i];
+                    if(firstFlow < 0) firstFlow = i;
+                }
+            }
+            if(firstFlow < 0) continue;
+
+            Column column;
+            column.cell = cell;
+            column.group = flowKind / 2;
+            column.extraTurn = flowKind % 2 != 0;
+            column.target = flowTarget[firstFlow];
+            column.destination = table.cellOf(column.target);
+            column.slot = w.columns.size();
+            column.region = regionIndex;
+            if(column.slot == w.counts.size()) w.counts.emplace_back(states, 0.0);
+            w.columns.push_back(column);
+
+            vector<double>& count = w.counts[column.slot];
+            auto update = [&](int state) {
+                double sum = w.inflow[state];
+                double stay = 0.0;
+                for(int face = 1; face <= faces; face++) {
+                    double p = table.faceProbability(face);
+                    int target = table.next(state, face);
+                    if(target == state) stay += p;
+                    else sum += p * count[target];
+                }
+                return sum / (1.0 - stay);
+            };
+            bool converged = BoardAnalyzer::iterate(count, region, update, startState, 1e-12);
+            for(int i = flowOffsets[cell]; i < flowOffsets[cell + 1]; i++) w.inflow[flowState[i]] = 0.0;
+            if(!converged) return false;
+        }
+        return true;
+    }
+
+    // Exact change in expected turns from the start when every column's rolls go to its destination
+    // instead; INFINITY when that makes the final cell unreachable
+    double price(Workspace& w, const vector<double>& expected) {
+        int n = (int)w.columns.size();
+        if(n == 0) return 0.0;
+        w.matrix.resize((size_t)n * n);
+        w.rhs.resize(n);
+        w.turnChange.resize(n);
+        for(int j = 0; j < n; j++) {
+            const Column& column = w.columns[j];
+            int to = stateAt(column.destination, column.group);
+            w.turnChange[j] = column.extraTurn ? (double)(to == finished) - (double)(column.target == finished) : 0.0;
+        }
+        for(int i = 0; i < n; i++) {
+            int from = w.columns[i].target;
+            int to = stateAt(w.columns[i].destination, w.columns[i].group);
+            w.rhs[i] = expected[to] - expected[from];
+            for(int j = 0; j < n; j++) {
+                const vector<double>& count = w.counts[w.columns[j].slot];
+                double change = count[to] - count[from];
+                w.rhs[i] += change * w.turnChange[j];
+                w.matrix[(size_t)i * n + j] = (i == j ? 1.0 : 0.0) - change;
+            }
+        }
+        if(!DenseLinearSolver::solve(w.matrix.data(), w.rhs.data(), n)) return INFINITY;
+        double delta = 0.0;
+        for(int j = 0; j < n; j++) {
+            delta += w.counts[w.columns[j].slot][startState] * (w.turnChange[j] + w.rhs[j]);
+        }
+        return delta;
+    }
+
+    // Points every column back at where its rolls go now, so price() of the columns alone is zero
+    void resetDestinations(Workspace& w) {
+        for(Column& column : w.columns) {
+            column.destination = table.cellOf(column.target);
+        }
+    }
+
+    void clear(Workspace& w) {
+        for(const Column& column : w.columns) {
+            vector<double>& count = w.counts[column.slot];
+            for(int state : w.regions[column.region]) count[state] = 0.0;
+        }
+        w.columns.clear();
+        w.regionCount = 0;
+    }
+};
+
+// Effect of one entity on the expected game length (turns from the start cell)
+struct EntitySensitivity {
+    int start;
+    int end;
+    bool isSnake;
+    double removeDelta;               // change if the entity is removed
+    double shiftDownDelta;            // change if its start moves down by the shift distance
+    double shiftUpDelta;              // change if its start moves up by the shift distance
+    bool canShiftDown;                // false when the shifted start is taken, breaks the geometry or the rules reject it
+    bool canShiftUp;
+    bool exact;                       // false only when a landing-count solve did not converge (deltas are NaN)
+    vector<double> removeSeatWinDelta;  // per-seat win probability changes (refineExact only)
+    vector<double> shiftDownSeatWinDelta;
+    vector<double> shiftUpSeatWinDelta;
+};
+
+// Per-entity sensitivity report. analyze() solves the expected turns once and prices every
+// removal and shift exactly with LandingRedirects: a variant only sends the rolls that land on
+// the entity's start, the shifted start, and the starts of entities chained into either,
+// somewhere else. That costs one landing-count solve per such cell over the states that can
+// reach it, and the start cell's solve is shared by the entity's three variants.
+// Per-seat win odds need the whole game-length distribution, which has no low-rank update, so
+// analyze() leaves them empty; refineExact() fills them by re-solving each variant's
+// distribution, in parallel across entities but at a full solve per variant.
+class SensitivityAnalyzer {
+private:
+    static bool canPlace(Board* board, int start, int end, bool isSnake) {
+        int cells = board->getBoardSize();
+        return start >= 1 && start < cells && end >= 1 && end <= cells
+            && (isSnake ? end < start : end > start) && board->getEntity(start) == nullptr;
+    }
+
+    static vector<double> seatWinOdds(Board* board, SnakeAndLadderRules* rules, const DiceDistribution& dice, int players, double& meanTurns) {
+        TransitionTable table(board, rules, dice);
+        GameLengthDistribution single = GameLengthAnalyzer::singlePlayer(table);
+        meanTurns = single.mean();
+        return MultiPlayerAnalyzer::analyze(single, players).seatWinProbability;
+    }
+
+    // Exact change in expected turns when the entity at start is removed (newStart 0) or moved to
+    // newStart. The edit is made on copy, and undone, only to read which landing outcomes it
+    // changes; columns already in the workspace for this entity are reused. False when the rules
+    // reject the edited board.
+    static bool variantDelta(Board& copy, SnakeAndLadderRules* rules, LandingRedirects& redirects,
+                             LandingRedirects::Workspace& workspace, const unordered_map<int, vector<int>>& startsEndingAt,
+                             const vector<double>& expected, int start, int end, int newStart, double& delta) {
+        vector<int> seeds(1, start);
+        if(newStart > 0) seeds.push_back(newStart);
+        vector<int> candidates = IncrementalAnalyzer::chainedInto(startsEndingAt, seeds);
+        vector<int> before = IncrementalAnalyzer::outcomesAt(&copy, rules, candidates);
+
+        copy.removeBoardEntity(start);
+        vector<BoardEntityRecord> moved(1, BoardEntityRecord{newStart, end, end < newStart});
+        bool allowed = newStart <= 0 || copy.addBoardEntities(moved);
+        if(allowed && !rules->bindBoard(&copy)) {
+            copy.removeBoardEntity(newStart);  // only an added entity can close a cycle
+            allowed = false;
+        }
+        vector<int> after;
+        if(allowed) {
+            after = IncrementalAnalyzer::outcomesAt(&copy, rules, candidates);
+            if(newStart > 0) copy.removeBoardEntity(newStart);
+        }
+        copy.addBoardEntities(vector<BoardEntityRecord>(1, BoardEntityRecord{start, end, end < start}));
+        rules->bindBoard(&copy);
+        if(!allowed) return false;
+
+        redirects.resetDestinations(workspace);
+        for(size_t i = 0; i < candidates.size(); i++) {
+            if(after[i] == before[i]) continue;
+            bool solved = false;
+            for(auto& column : workspace.columns) solved = solved || column.cell == candidates[i];
+            if(!solved && !redirects.addColumns(workspace, candidates[i])) {
+                delta = NAN;
+                return true;
+            }
+            for(auto& column : workspace.columns) {
+                if(column.cell == candidates[i]) column.destination = after[i];
+            }
+        }
+        delta = redirects.price(workspace, expected);
+        return true;
+    }
+
+public:
+    static vector<EntitySensitivity> analyze(Board* board, SnakeAndLadderRules* rules, const DiceDistribution& dice, int shift = 1) {
+        vector<EntitySensitivity> report;
+        TransitionTable table(board, rules, dice);
+        vector<double> expected;
+        if(!BoardAnalyzer::solveExpectedTurns(table, expected, 1e-12)) {
+            return report;
+        }
+        LandingRedirects redirects(table, rules);
+        LandingRedirects::Workspace workspace;
+
+        int side = (int)lround(sqrt((double)board->getBoardSize()));
+        vector<BoardEntityRecord> records;
+        unordered_map<int, vector<int>> startsEndingAt;
+        for(auto entity : board->getEntities()) {
+            records.push_back(BoardEntityRecord{entity->getStart(), entity->getEnd(), entity->getEnd() < entity->getStart()});
+            startsEndingAt[entity->getEnd()].push_back(entity->getStart());
+        }
+        Board copy(side);
+        copy.addBoardEntities(records);
+        rules->bindBoard(&copy);
+
+        for(auto entity : board->getEntities()) {
+            EntitySensitivity item;
+            item.start = entity->getStart();
+            item.end = entity->getEnd();
+            item.isSnake = item.end < item.start;
+            item.shiftDownDelta = 0.0;
+            item.shiftUpDelta = 0.0;
+
+            redirects.clear(workspace);
+            variantDelta(copy, rules, redirects, workspace, startsEndingAt, expected, item.start, item.end, 0, item.removeDelta);
+
+            int down = item.start - shift, up = item.start + shift;
+            item.canShiftDown = canPlace(board, down, item.end, item.isSnake)
+                && variantDelta(copy, rules, redirects, workspace, startsEndingAt, expected, item.start, item.end, down, item.shiftDownDelta);
+            item.canShiftUp = canPlace(board, up, item.end, item.isSnake)
+                && variantDelta(copy, rules, redirects, workspace, startsEndingAt, expected, item.start, item.end, up, item.shiftUpDelta);
+            if(!item.canShiftDown) item.shiftDownDelta = 0.0;
+            if(!item.canShiftUp) item.shiftUpDelta = 0.0;
+            item.exact = !isnan(item.removeDelta) && !isnan(item.shiftDownDelta) && !isnan(item.shiftUpDelta);
+            report.push_back(item);
+        }
+        redirects.clear(workspace);
+        rules->bindBoard(board);
+        return report;
+    }
+
+    // Re-solves every variant in full and fills per-seat win deltas for players seats.
+    // Each worker builds its own boards and rules (makeRules), so rules need not be thread safe.
+    static void refineExact(Board* board, function<SnakeAndLadderRules*()> makeRules, const DiceDistribution& dice,
+                            int players, int shift, vector<EntitySensitivity>& report, int threads = 0) {
+        int side = (int)lround(sqrt((double)board->getBoardSize()));
+        vector<BoardEntityRecord> records;
+        for(auto entity : board->getEntities()) {
+            records.push_back(BoardEntityRecord{entity->getStart(), entity->getEnd(), entity->getEnd() < entity->getStart()});
+        }
+
+        SnakeAndLadderRules* baseRules = makeRules();
+        double baseMean;
+        vector<double> baseOdds = seatWinOdds(board, baseRules, dice, players, baseMean);
+        delete baseRules;
+
+        // Mean turns and seat odds with the entity at index removed, or moved to newStart
+        auto variant = [&](size_t index, int newStart, double& meanDelta, vector<double>& seatDelta) {
+            vector<BoardEntityRecord> changed;
+            changed.reserve(records.size());
+            for(size_t i = 0; i < records.size(); i++) {
+                if(i != index) changed.push_back(records[i]);
+            }
+            if(newStart > 0) {
+                changed.push_back(BoardEntityRecord{newStart, records[index].end, records[index].isSnake});
+            }
+            Board copy(side);
+            copy.addBoardEntities(changed);
+            SnakeAndLadderRules* rules = makeRules();
+            double mean;
+            vector<double> odds = seatWinOdds(&copy, rules, dice, players, mean);
+            delete rules;
+
+            meanDelta = mean - baseMean;
+            seatDelta.resize(players);
+            for(int seat = 0; seat < players; seat++) {
+                seatDelta[seat] = odds[seat] - baseOdds[seat];
+            }
+        };
+
+        // Report entries follow board->getEntities() order, like records
+        atomic<size_t> nextEntity(0);
+        auto worker = [&]() {
+            for(size_t i = nextEntity++; i < report.size() && i < records.size(); i = nextEntity++) {
+                EntitySensitivity& item = report[i];
+                variant(i, 0, item.removeDelta, item.removeSeatWinDelta);
+                if(item.canShiftDown) variant(i, item.start - shift, item.shiftDownDelta, item.shiftDownSeatWinDelta);
+                if(item.canShiftUp) variant(i, item.start + shift, item.shiftUpDelta, item.shiftUpSeatWinDelta);
+                item.exact = true;
+            }
+        };
+        WorkerThreads::run(WorkerThreads::resolve(threads), worker);
+    }
+};
+
+// What a placement search aims for
+struct PlacementGoal {
+    double quantile = 0.0;  // 0 scores mean turns; otherwise that percentile of game length (0.5 = median)
+    double target = 0.0;    // placements are ranked by |metric - target|, so 0 asks for the fastest board
+    bool ladders = true;
+    bool snakes = true;
+};
+
+struct PlacementCandidate {
+    int start;
+    int end;
+    bool isSnake;
+    double meanTurns;  // expected turns with the entity added
+    double metric;     // the goal's metric with the entity added
+    double score;      // |metric - target|
+    bool heuristic;    // metric is exact, but a placement screened out may have ranked higher
+};
+
+// Finds the best places to add one snake or ladder. Every (start, end) pair is scored
+// without re-solving the board: adding an entity at start only redirects the rolls that
+// land there, a low-rank change, so one landing-count solve per start prices every end
+// exactly (LandingRedirects). The best estimates are then re-checked with an
+// IncrementalAnalyzer per worker. For mean goals under rules that do not chain entities the
+// screen is exact, so verification stops once no remaining candidate can make the top k.
+// Percentile goals are screened by scaling with the mean, which has no error bound: their
+// verification stops on the errors seen so far, and the results are marked heuristic.
+class PlacementSearch {
+private:
+    static double metricFor(const PlacementGoal& goal, double meanTurns, double baseMean, double baseMetric) {
+        // Percentiles are estimated by scaling with the mean until the candidate is verified
+        return goal.quantile > 0.0 ? baseMetric * meanTurns / baseMean : meanTurns;
+    }
+
+public:
+    // Top k placements for goal, best first. Screening assumes entities are not chained;
+    // the verification pass evaluates each returned placement exactly under makeRules.
+    static vector<PlacementCandidate> topPlacements(Board* board, function<SnakeAndLadderRules*()> makeRules,
+                                                    const DiceDistribution& dice, const PlacementGoal& goal,
+                                                    int k, int threads = 0) {
+        vector<PlacementCandidate> best;
+        int cells = board->getBoardSize();
+        if(k <= 0 || cells < 2) return best;
+        int threadCount = WorkerThreads::resolve(threads);
+
+        SnakeAndLadderRules* rules = makeRules();
+        TransitionTable table(board, rules, dice);
+        vector<double> expected;
+        if(!BoardAnalyzer::solveExpectedTurns(table, expected, 1e-12)) {
+            delete rules;
+            return best;
+        }
+        int startState = table.stateOf(0);
+        double baseMean = expected[startState];
+        double baseMetric = baseMean;
+        if(goal.quantile > 0.0) {
+            baseMetric = GameLengthAnalyzer::singlePlayer(table).percentile(goal.quantile);
+        }
+        LandingRedirects redirects(table, rules);
+        delete rules;
+
+        // Screening: each worker keeps its best poolSize estimates in a max-heap on score
+        size_t poolSize = max((size_t)1024, (size_t)k * 16);
+        auto worseScore = [](const PlacementCandidate& a, const PlacementCandidate& b) { return a.score < b.score; };
+        vector<vector<PlacementCandidate>> pools(threadCount);
+        atomic<int> nextPool(0), nextStart(1);
+        auto screen = [&]() {
+            vector<PlacementCandidate>& pool = pools[nextPool++];
+            LandingRedirects::Workspace workspace;
+
+            for(int start = nextStart++; start < cells; start = nextStart++) {
+                if(!board->canAddEntity(start) || !redirects.hasLandings(start)) continue;
+
+                // A start the game never lands on adds no columns: nothing placed there matters
+                redirects.clear(workspace);
+                if(!redirects.addColumns(workspace, start, true) || workspace.columns.empty()) continue;
+
+                for(int end = 1; end <= cells; end++) {
+                    bool isSnake = end < start;
+                    if(end == start || (isSnake ? !goal.snakes : !goal.ladders)) continue;
+
+                    // Mean turns after redirecting landings on start to end
+                    for(auto& column : workspace.columns) column.destination = end;
+                    double delta = redirects.price(workspace, expected);
+                    if(isinf(delta)) continue;  // redirect makes the finish unreachable
+
+                    PlacementCandidate candidate;
+                    candidate.start = start;
+                    candidate.end = end;
+                    candidate.isSnake = isSnake;
+                    candidate.meanTurns = baseMean + delta;
+                    candidate.metric = metricFor(goal, candidate.meanTurns, baseMean, baseMetric);
+                    candidate.score = fabs(candidate.metric - goal.target);
+                    candidate.heuristic = goal.quantile > 0.0;
+                    if(pool.size() < poolSize) {
+                        pool.push_back(candidate);
+                        push_heap(pool.begin(), pool.end(), worseScore);
+                    }
+                    else if(candidate.score < pool.front().score) {
+                        pop_heap(pool.begin(), pool.end(), worseScore);
+                        pool.back() = candidate;
+                        push_heap(pool.begin(), pool.end(), worseScore);
+                    }
+                }
+            }
+        };
+        WorkerThreads::run(threadCount, screen);
+
+        vector<PlacementCandidate> candidates;
+        for(auto& pool : pools) {
+            candidates.insert(candidates.end(), pool.begin(), pool.end());
+        }
+        sort(candidates.begin(), candidates.end(), worseScore);
+
+        // Verification, best estimate first. Stops once the next estimate, widened by twice
+        // the largest estimation error seen so far, cannot beat the k-th verified score. That
+        // is a proof only while every estimate has matched its verified score.
+        int side = (int)lround(sqrt((double)cells));
+        vector<BoardEntityRecord> records;
+        for(auto entity : board->getEntities()) {
+            records.push_back(BoardEntityRecord{entity->getStart(), entity->getEnd(), entity->getEnd() < entity->getStart()});
+        }
+        size_t minVerified = (size_t)k * 2;
+        vector<double> topScores;  // max-heap of the k best verified scores
+        double maxError = 0.0;
+        mutex verifiedLock;
+        atomic<size_t> nextCandidate(0);
+        auto verify = [&]() {
+            Board copy(side);
+            copy.addBoardEntities(records);
+            SnakeAndLadderRules* workerRules = makeRules();
+            IncrementalAnalyzer analyzer(&copy, workerRules, dice);
+
+            for(size_t i = nextCandidate++; i < candidates.size(); i = nextCandidate++) {
+                PlacementCandidate candidate = candidates[i];
+                {
+                    lock_guard<mutex> guard(verifiedLock);
+                    if(i >= minVerified && (int)topScores.size() >= k && candidate.score - 2.0 * maxError > topScores.front()) break;
+                }
+
+                if(!analyzer.addEntity(candidate.start, candidate.end)) continue;
+                candidate.meanTurns = analyzer.expectedTurnsFromStart();
+                candidate.metric = candidate.meanTurns;
+                if(goal.quantile > 0.0) {
+                    candidate.metric = GameLengthAnalyzer::singlePlayer(analyzer.getTable()).percentile(goal.quantile);
+                }
+                analyzer.removeEntity(candidate.start);
+                double estimate = candidate.score;
+                candidate.score = fabs(candidate.metric - goal.target);
+
+                lock_guard<mutex> guard(verifiedLock);
+                maxError = max(maxError, fabs(candidate.score - estimate));
+                best.push_back(candidate);
+                topScores.push_back(candidate.score);
+                push_heap(topScores.begin(), topScores.end());
+                if((int)topScores.size() > k) {
+                    pop_heap(topScores.begin(), topScores.end());
+                    topScores.pop_back();
+                }
+            }
+            delete workerRules;
+        };
+        WorkerThreads::run(threadCount, verify);
+
+        // Errors far above the solver tolerance mean the screen was not exact (chained rules)
+        bool heuristic = goal.quantile > 0.0 || maxError > 1e-9 * max(1.0, baseMean);
+        for(auto& candidate : best) {
+            candidate.heuristic = heuristic;
+        }
+        sort(best.begin(), best.end(), worseScore);
+        if((int)best.size() > k) best.resize(k);
+        return best;
+    }
+};
+
+// What the board designer aims for; a term with weight 0 is ignored
+struct DesignTargets {
+    double meanTurns = 30.0;       // expected rounds until someone wins
+    double stdDevTurns = 0.0;      // spread of the game length in rounds
+    int entities = 20;             // snakes + ladders
+    int players = 2;               // seat fairness is measured at this table size
+    double meanWeight = 1.0;
+    double stdDevWeight = 0.0;
+    double fairnessWeight = 1.0;   // gap between the best and the worst seat's win probability
+    double entityWeight = 0.1;
+};
+
+struct DesignOptions {
+    int population = 64;
+    int generations = 200;
+    int elite = 4;                 // best boards copied unchanged into the next generation
+    int tournament = 3;
+    uint64_t seed = 1;
+    int threads = 0;               // 0 = all cores
+    int simulatedGames = 0;        // > 0: fitness from GameSimulator instead of the exact analyzers
+    string checkpointPath;         // empty: no checkpoints; an existing checkpoint is resumed
+    int checkpointEvery = 10;      // generations between checkpoints
+};
+
+struct DesignedBoard {
+    vector<BoardEntityRecord> records;  // sorted by start
+    double cost;
+    double meanTurns;
+    double stdDevTurns;
+    vector<double> seatWinProbability;
+};
+
+// Offline board designer: a genetic search over entity lists (tournament selection, uniform
+// crossover by start cell, elitism) whose mutation count anneals from several edits per child
+// down to one. Fitness uses the exact analyzers, or GameSimulator when asked or when players
+// interact. Children are bred and scored in parallel; child i of generation g draws from its own
+// RNG stream (seed, g, i), so a run, and a run resumed from a checkpoint, is the same for any
+// thread count. Checkpoints and results are written in the board file format.
+class BoardDesigner {
+private:
+    static void sortRecords(vector<BoardEntityRecord>& records) {
+        sort(records.begin(), records.end(),
+            [](const BoardEntityRecord& a, const BoardEntityRecord& b) { return a.start < b.start; });
+    }
+
+    static int randomIn(FastRandom& rng, int low, int high) {
+        return low + (int)rng.nextBelow((uint32_t)(high - low + 1));
+    }
+
+    // Uniform free start for the kind, or 0 if none is left
+    static int freeStart(FastRandom& rng, const vector<char>& occupied, int cells, bool isSnake) {
+        int low = isSnake ? 2 : 1;
+        int high = isSnake ? cells - 1 : cells - 2;
+        int free = 0;
+        for(int cell = low; cell <= high; cell++) free += occupied[cell] ? 0 : 1;
+        if(free == 0) return 0;
+        int rank = (int)rng.nextBelow((uint32_t)free);
+        for(int cell = low; cell <= high; cell++) {
+            if(!occupied[cell] && rank-- == 0) return cell;
+        }
+        return 0;
+    }
+
+    // Same end ranges as BoardSetupStrategy::placeEntity: snakes in [1, start), ladders in (start, cells)
+    static int randomEnd(FastRandom& rng, int cells, int start, bool isSnake) {
+        return isSnake ? randomIn(rng, 1, start - 1) : randomIn(rng, start + 1, cells - 1);
+    }
+
+    static bool addRandomEntity(FastRandom& rng, vector<BoardEntityRecord>& records, vector<char>& occupied, int cells) {
+        bool isSnake = rng.nextBelow(2) == 0;
+        int start = freeStart(rng, occupied, cells, isSnake);
+        if(start == 0) return false;
+        occupied[start] = 1;
+        records.push_back(BoardEntityRecord{start, randomEnd(rng, cells, start, isSnake), isSnake});
+        return true;
+    }
+
+    static vector<char> occupiedCells(const vector<BoardEntityRecord>& records, int cells) {
+        vector<char> occupied(cells + 1, 0);
+        for(auto& record : records) occupied[record.start] = 1;
+        return occupied;
+    }
+
+    static void mutate(FastRandom& rng, vector<BoardEntityRecord>& records, int cells, int targetEntities) {
+        vector<char> occupied = occupiedCells(records, cells);
+        int kind = (int)rng.nextBelow(4);
+        // Grow or shrink towards the target count more often than away from it
+        if(records.empty()) kind = 0;
+        else if(kind == 0 && (int)records.size() > targetEntities && rng.nextBelow(2) == 0) kind = 1;
+        else if(kind == 1 && (int)records.size() < targetEntities && rng.nextBelow(2) == 0) kind = 0;
+
+        if(kind == 0) {
+            addRandomEntity(rng, records, occupied, cells);
+            return;
+        }
+        size_t index = rng.nextBelow((uint32_t)records.size());
+        BoardEntityRecord& record = records[index];
+        if(kind == 1) {
+            records.erase(records.begin() + index);
+        }
+        else if(kind == 2) {
+            record.end = randomEnd(rng, cells, record.start, record.isSnake);
+        }
+        else {
+            // Move the start, keeping the kind; the end is redrawn if the geometry no longer holds
+            occupied[record.start] = 0;
+            int start = freeStart(rng, occupied, cells, record.isSnake);
+            if(start == 0) return;
+            record.start = start;
+            if(record.isSnake ? record.end >= start : (record.end <= start || record.end >= cells)) {
+                record.end = randomEnd(rng, cells, start, record.isSnake);
+            }
+        }
+    }
+
+    // Each start cell is inherited from one parent chosen at random
+    static vector<BoardEntityRecord> crossover(FastRandom& rng, const vector<BoardEntityRecord>& a,
+                                               const vector<BoardEntityRecord>& b) {
+        vector<BoardEntityRecord> child;
+        size_t i = 0, j = 0;
+        while(i < a.size() || j < b.size()) {
+            if(j == b.size() || (i < a.size() && a[i].start < b[j].start)) {
+                if(rng.nextBelow(2) == 0) child.push_back(a[i]);
+                i++;
+            }
+            else if(i == a.size() || b[j].start < a[i].start) {
+                if(rng.nextBelow(2) == 0) child.push_back(b[j]);
+                j++;
+            }
+            else {
+                child.push_back(rng.nextBelow(2) == 0 ? a[i] : b[j]);
+                i++;
+                j++;
+            }
+        }
+        return child;
+    }
+
+    static bool checkpointLine(const string& line, const string& prefix) {
+        return line.compare(0, prefix.size(), prefix) == 0;
+    }
+
+    // "# generation g" followed by one "# board" block per population member
+    static bool loadCheckpoint(const string& path, int cells, int& generation, vector<vector<BoardEntityRecord>>& population) {
+        ifstream in(path);
+        if(!in) return false;
+        generation = -1;
+        population.clear();
+        string line, block;
+        bool inBlock = false;
+        auto closeBlock = [&]() {
+            if(!inBlock) return true;
+            vector<BoardEntityRecord> records;
+            if(!BoardFileLoader::parse(block.data(), block.size(), cells, records)) return false;
+            sortRecords(records);
+            population.push_back(records);
+            block.clear();
+            return true;
+        };
+        while(getline(in, line)) {
+            if(checkpointLine(line, "# generation ")) {
+                generation = atoi(line.c_str() + 13);
+            }
+            else if(checkpointLine(line, "# board")) {
+                if(!closeBlock()) return false;
+                inBlock = true;
+            }
+            else if(inBlock) {
+                block += line;
+                block += '\n';
+            }
+        }
+        if(!closeBlock()) return false;
+        return generation >= 0 && !population.empty();
+    }
+
+    static void saveCheckpoint(const string& path, int generation, const vector<DesignedBoard>& population) {
+        // Written aside and renamed, so an interrupted write never replaces a good checkpoint
+        string temporary = path + ".tmp";
+        {
+            ofstream out(temporary);
+            out << "# board designer checkpoint\n# generation " << generation << '\n';
+            for(size_t i = 0; i < population.size(); i++) {
+                out << "# board " << i << " cost " << population[i].cost << '\n';
+                BoardFileLoader::write(out, population[i].records);
+            }
+            if(!out) {
+                cout << "Unable to write checkpoint: " << path << endl;
+                return;
+            }
+        }
+        rename(temporary.c_str(), path.c_str());
+    }
+
+public:
+    // Scores one entity list; boards that cannot be finished get an infinite cost
+    static DesignedBoard evaluate(int side, const vector<BoardEntityRecord>& records, function<SnakeAndLadderRules*()> makeRules,
+                                  const DiceDistribution& dice, const DesignTargets& targets, const DesignOptions& options) {
+        DesignedBoard result;
+        result.records = records;
+        result.cost = INFINITY;
+        result.meanTurns = 0.0;
+        result.stdDevTurns = 0.0;
+        int players = max(1, targets.players);
+
+        Board board(side);
+        SnakeAndLadderRules* rules = makeRules();
+        if(!board.addBoardEntities(records) || !rules->bindBoard(&board)) {
+            delete rules;
+            return result;
+        }
+        TransitionTable table(&board, rules, dice);
+        bool simulate = options.simulatedGames > 0 || rules->playersInteract();
+        delete rules;
+
+        if(simulate) {
+            int games = options.simulatedGames > 0 ? options.simulatedGames : 2000;
+            SimulationStats stats = GameSimulator::simulate(table, players, games, options.seed);
+            result.meanTurns = stats.meanTurns;
+            result.stdDevTurns = stats.stdDevTurns;
+            result.seatWinProbability = stats.seatWinRates;
+        }
+        else {
+            GameLengthDistribution single = GameLengthAnalyzer::singlePlayer(table);
+            if(single.unfinishedMass > 1e-6) return result;
+            MultiPlayerOutcome outcome = MultiPlayerAnalyzer::analyze(single, players);
+            double squares = 0.0;
+            for(size_t t = 1; t < outcome.endsAtRound.size(); t++) {
+                squares += (double)t * t * outcome.endsAtRound[t];
+            }
+            result.meanTurns = outcome.meanRounds;
+            result.stdDevTurns = sqrt(max(0.0, squares - outcome.meanRounds * outcome.meanRounds));
+            result.seatWinProbability = outcome.seatWinProbability;
+        }
+        if(result.meanTurns <= 0.0) return result;
+
+        auto seats = minmax_element(result.seatWinProbability.begin(), result.seatWinProbability.end());
+        double cost = targets.meanWeight * fabs(result.meanTurns - targets.meanTurns) / max(1.0, targets.meanTurns);
+        cost += targets.stdDevWeight * fabs(result.stdDevTurns - targets.stdDevTurns) / max(1.0, targets.stdDevTurns);
+        cost += targets.fairnessWeight * (*seats.second - *seats.first);
+        cost += targets.entityWeight * abs((int)records.size() - targets.entities) / max(1.0, (double)targets.entities);
+        result.cost = cost;
+        return result;
+    }
+
+    // Final population, best first
+    static vector<DesignedBoard> design(int side, function<SnakeAndLadderRules*()> makeRules, const DiceDistribution& dice,
+                                        const DesignTargets& targets, const DesignOptions& options) {
+        int cells = side * side;
+        int size = max(2, options.population);
+        int elite = min(max(0, options.elite), size);
+        int threadCount = WorkerThreads::resolve(options.threads);
+        vector<DesignedBoard> population(size), next(size);
+        if(cells < 4) {
+            cout << "Board is too small to design." << endl;
+            return vector<DesignedBoard>();
+        }
+
+        // Generation 0 is random unless a checkpoint is resumed
+        vector<vector<BoardEntityRecord>> seeds;
+        int firstGeneration = 0;
+        if(!options.checkpointPath.empty() && loadCheckpoint(options.checkpointPath, cells, firstGeneration, seeds)) {
+            cout << "Resuming board design from generation " << firstGeneration << "." << endl;
+        }
+        else {
+            seeds.clear();
+            firstGeneration = 0;
+        }
+        atomic<int> nextIndex(0);
+        auto seedWorker = [&]() {
+            for(int i = nextIndex++; i < size; i = nextIndex++) {
+                vector<BoardEntityRecord> records;
+                if(i < (int)seeds.size()) {
+                    records = seeds[i];
+                }
+                else {
+                    FastRandom rng(RandomStripeGenerator::stripeSeed(options.seed, (uint64_t)i));
+                    vector<char> occupied(cells + 1, 0);
+                    for(int k = 0; k < targets.entities && addRandomEntity(rng, records, occupied, cells); k++) {}
+                    sortRecords(records);
+                }
+                population[i] = evaluate(side, records, makeRules, dice, targets, options);
+            }
+        };
+        WorkerThreads::run(threadCount, seedWorker);
+
+        auto byCost = [](const DesignedBoard& a, const DesignedBoard& b) { return a.cost < b.cost; };
+        stable_sort(population.begin(), population.end(), byCost);
+
+        int generations = max(0, options.generations);
+        for(int generation = firstGeneration; generation < generations; generation++) {
+            // Annealed mutation: up to four edits per child early on, one by the last generation
+            double temperature = 1.0 - (double)generation / max(1, generations);
+            int maxEdits = 1 + (int)(3.0 * temperature);
+
+            nextIndex = elite;
+            auto breed = [&]() {
+                for(int i = nextIndex++; i < size; i = nextIndex++) {
+                    FastRandom rng(RandomStripeGenerator::stripeSeed(options.seed, (uint64_t)(generation + 1) * size + i));
+                    auto pick = [&]() -> const DesignedBoard& {
+                        int best = (int)rng.nextBelow((uint32_t)size);
+                        for(int round = 1; round < options.tournament; round++) {
+                            best = min(best, (int)rng.nextBelow((uint32_t)size));  // population is sorted by cost
+                        }
+                        return population[best];
+                    };
+                    const DesignedBoard& first = pick();
+                    const DesignedBoard& second = pick();
+                    vector<BoardEntityRecord> child = crossover(rng, first.records, second.records);
+                    int edits = 1 + (int)rng.nextBelow((uint32_t)maxEdits);
+                    for(int edit = 0; edit < edits; edit++) {
+                        mutate(rng, child, cells, targets.entities);
+                    }
+                    sortRecords(child);
+                    next[i] = evaluate(side, child, makeRules, dice, targets, options);
+                }
+            };
+            WorkerThreads::run(threadCount, breed);
+
+            for(int i = 0; i < elite; i++) {
+                next[i] = population[i];
+            }
+            population.swap(next);
+            stable_sort(population.begin(), population.end(), byCost);
+
+            bool last = generation + 1 == generations;
+            if(!options.checkpointPath.empty() && (last || (options.checkpointEvery > 0 && (generation + 1) % options.checkpointEvery == 0))) {
+                saveCheckpoint(options.checkpointPath, generation + 1, population);
+                cout << "Generation " << generation + 1 << ": best cost " << population[0].cost
+                     << ", mean turns " << population[0].meanTurns << endl;
+            }
+        }
+        return population;
+    }
+
+    // Board file with the measured statistics as comments; load it with FileBoardSetupStrategy
+    static bool writeBoardFile(const string& path, const DesignedBoard& board) {
+        ofstream out(path);
+        if(!out) {
+            cout << "Unable to write board file: " << path << endl;
+            return false;
+        }
+        out << "# designed board: mean turns " << board.meanTurns << ", std dev " << board.stdDevTurns << ", seat wins";
+        for(double seat : board.seatWinProbability) {
+            out << ' ' << seat;
+        }
+        out << '\n';
+        BoardFileLoader::write(out, board.records);
+        return (bool)out;
+    }
+};
+
+// Canonical content hash over (cell count, sorted entity list, dice faces, rules id)
+class BoardHasher {
+private:
+    static uint64_t mix(uint64_t h, uint64_t value) {
+        h ^= value + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+public:
+    // diceKey is the face count for a fair die (see DiceDistribution::getKey)
+    static uint64_t hashBoard(Board* board, uint64_t diceKey, string rulesId) {
+        vector<pair<int, int>> entities;
+        for(auto entity : board->getEntities()) {
+            entities.push_back(make_pair(entity->getStart(), entity->getEnd()));
+        }
+        sort(entities.begin(), entities.end());
+
+        uint64_t h = mix(0x534E414B454C4144ULL, (uint64_t)board->getBoardSize());
+        h = mix(h, entities.size());
+        for(auto& entity : entities) {
+            h = mix(h, ((uint64_t)(uint32_t)entity.first << 32) | (uint32_t)entity.second);
+        }
+        h = mix(h, diceKey);
+        for(char c : rulesId) {
+            h = mix(h, (uint64_t)(unsigned char)c);
+        }
+        return h;
+    }
+
+    static uint64_t combine(uint64_t h, uint64_t value) {
+        return mix(h, value);
+    }
+};
+
+// LRU cache of analysis results; evicted and unsaved entries spill to an append-only file
+class AnalysisCache {
+private:
+    size_t capacity;
+    string spillPath;
+    list<pair<uint64_t, vector<double>>> lruList;  // most recent first
+    unordered_map<uint64_t, list<pair<uint64_t, vector<double>>>::iterator> memoryIndex;
+    unordered_map<uint64_t, streamoff> fileIndex;  // key -> record offset in the spill file
+
+    // First word of the spill file. Bump the version whenever cached results change meaning
+    // (solver output, simulator RNG streams), so files from older builds are discarded.
+    static const uint64_t fileMagic = 0x534C434143480000ULL;  // "SLCACH" + version
+    static const uint64_t fileVersion = 2;
+
+    // Records whose payload runs past the end of the file are treated as missing
+    static bool payloadFits(istream& in, streamoff fileSize, uint32_t count) {
+        streamoff position = in.tellg();
+        return position >= 0 && (uint64_t)count <= (uint64_t)(fileSize - position) / sizeof(double);
+    }
+
+    void loadFileIndex() {
+        ifstream in(spillPath, ios::binary | ios::ate);
+        if(!in) return;
+        streamoff fileSize = in.tellg();
+        in.seekg(0, ios::beg);
+
+        uint64_t header = 0;
+        if(fileSize < 0 || !in.read((char*)&header, sizeof(header)) || header != (fileMagic | fileVersion)) {
+            in.close();
+            if(fileSize > 0) {
+                cout << "Discarding " << spillPath << ": written by a different version." << endl;
+            }
+            remove(spillPath.c_str());
+            return;
+        }
+
+        streamoff goodEnd = in.tellg();
+        while(true) {
+            streamoff offset = in.tellg();
+            uint64_t key;
+            uint32_t count;
+            if(!in.read((char*)&key, sizeof(key)) || !in.read((char*)&count, sizeof(count))) break;
+            if(!payloadFits(in, fileSize, count)) break;  // torn final record
+            if(!in.seekg((streamoff)count * sizeof(double), ios::cur)) break;
+            fileIndex[key] = offset;
+            goodEnd = in.tellg();
+        }
+        in.close();
+
+        // Later spills are appended, so bytes of a torn record would sit in front of them and hide
+        // them from the next load; cut the file back to the last whole record
+        if(goodEnd < fileSize) {
+            cout << "Dropping a torn record at the end of " << spillPath << "." << endl;
+            error_code error;
+            filesystem::resize_file(spillPath, (uintmax_t)goodEnd, error);
+            if(error) {
+                cout << "Could not truncate " << spillPath << "; discarding it." << endl;
+                fileIndex.clear();
+                remove(spillPath.c_str());
+            }
+        }
+    }
+
+    void spill(uint64_t key, vector<double>& value) {
+        if(spillPath.empty() || fileIndex.count(key)) return;
+
+        ofstream out(spillPath, ios::binary | ios::app);
+        if(!out) return;
+        out.seekp(0, ios::end);
+        streamoff offset = out.tellp();
+        if(offset == 0) {
+            uint64_t header = fileMagic | fileVersion;
+            out.write((char*)&header, sizeof(header));
+            offset = out.tellp();
+        }
+        uint32_t count = (uint32_t)value.size();
+        out.write((char*)&key, sizeof(key));
+        out.write((char*)&count, sizeof(count));
+        out.write((char*)value.data(), (streamsize)count * sizeof(double));
+        if(out) {
+            fileIndex[key] = offset;
+        }
+    }
+
+    bool readSpilled(uint64_t key, vector<double>& value) {
+        auto it = fileIndex.find(key);
+        if(it == fileIndex.end()) return false;
+
+        ifstream in(spillPath, ios::binary | ios::ate);
+        streamoff fileSize = in.tellg();
+        uint64_t storedKey;
+        uint32_t count;
+        in.seekg(it->second);
+        if(!in.read((char*)&storedKey, sizeof(storedKey)) || !in.read((char*)&count, sizeof(count)) || storedKey != key
+           || !payloadFits(in, fileSize, count)) {
+            return false;
+        }
+        value.resize(count);
+        return (bool)in.read((char*)value.data(), (streamsize)count * sizeof(double));
+    }
+
+    void insertMemory(uint64_t key, vector<double> value) {
+        lruList.push_front(make_pair(key, move(value)));
+        memoryIndex[key] = lruList.begin();
+
+        while(lruList.size() > capacity) {
+            auto& oldest = lruList.back();
+            spill(oldest.first, oldest.second);
+            memoryIndex.erase(oldest.first);
+            lruList.pop_back();
+        }
+    }
+
+public:
+    AnalysisCache(size_t entries, string path) {
+        capacity = max((size_t)1, entries);
+        spillPath = path;
+        loadFileIndex();
+    }
+
+    bool lookup(uint64_t key, vector<double>& value) {
+        auto it = memoryIndex.find(key);
+        if(it != memoryIndex.end()) {
+            lruList.splice(lruList.begin(), lruList, it->second);
+            value = it->second->second;
+            return true;
+        }
+
+        if(readSpilled(key, value)) {
+            insertMemory(key, value);
+            return true;
+        }
+        return false;
+    }
+
+    void store(uint64_t key, vector<double> value) {
+        auto it = memoryIndex.find(key);
+        if(it != memoryIndex.end()) {
+            lruList.erase(it->second);
+            memoryIndex.erase(it);
+        }
+        insertMemory(key, move(value));
+    }
+
+    // Persist everything still only held in memory
+    void flush() {
+        for(auto& entry : lruList) {
+            spill(entry.first, entry.second);
+        }
+    }
+
+    ~AnalysisCache() {
+        flush();
+    }
+};
+
+// Cache-fronted entry points for the exact solver and the simulator
+class CachedBoardAnalyzer {
+private:
+    AnalysisCache cache;
+
+    enum QueryKind {
+        EXPECTED_TURNS = 1,
+        SIMULATION = 2
+    };
+
+    // The standard board's tables are baked into the binary
+    static uint64_t standardBoardHash() {
+        static uint64_t hash = BoardHasher::hashBoard(StandardBoardSetupStrategy::sharedBoard(), StandardBoardLayout::faces, "STANDARD");
+        return hash;
+    }
+
+public:
+    CachedBoardAnalyzer(size_t entries = 256, string spillPath = "board_analysis.cache") : cache(entries, spillPath) {}
+
+    // Expected turns to finish from every cell (index 0 is the starting position)
+    bool expectedTurns(Board* board, int faces, SnakeAndLadderRules* rules, vector<double>& result) {
+        return expectedTurns(board, DiceDistribution::fair(faces), rules, result);
+    }
+
+    bool expectedTurns(Board* board, const DiceDistribution& dice, SnakeAndLadderRules* rules, vector<double>& result) {
+        uint64_t boardHash = BoardHasher::hashBoard(board, dice.getKey(), rules->getRulesId());
+        if(boardHash == standardBoardHash()) {
+            result.assign(StandardBoardTables::expectedTurns.begin(), StandardBoardTables::expectedTurns.end());
+            return true;
+        }
+        
+        uint64_t key = BoardHasher::combine(boardHash, EXPECTED_TURNS);
+        if(cache.lookup(key, result)) {
+            return true;
+        }
+
+        TransitionTable table(board, rules, dice);
+        if(!BoardAnalyzer::solveExpectedTurns(table, result)) {
+            return false;
+        }
+        cache.store(key, result);
+        return true;
+    }
+
+    SimulationStats simulate(Board* board, int faces, SnakeAndLadderRules* rules, int players, int games, uint64_t seed) {
+        return simulate(board, DiceDistribution::fair(faces), rules, players, games, seed);
+    }
+
+    SimulationStats simulate(Board* board, const DiceDistribution& dice, SnakeAndLadderRules* rules, int players, int games, uint64_t seed) {
+        uint64_t key = BoardHasher::hashBoard(board, dice.getKey(), rules->getRulesId());
+        key = BoardHasher::combine(key, SIMULATION);
+        key = BoardHasher::combine(key, (uint64_t)players);
+        key = BoardHasher::combine(key, (uint64_t)games);
+        key = BoardHasher::combine(key, seed);
+
+        // Stored as [games, mean, stddev, seat win rates...]
+        vector<double> packed;
+        SimulationStats stats;
+        if(cache.lookup(key, packed) && packed.size() == (size_t)players + 3) {
+            stats.games = (int)packed[0];
+            stats.meanTurns = packed[1];
+            stats.stdDevTurns = packed[2];
+            stats.seatWinRates.assign(packed.begin() + 3, packed.end());
+            return stats;
+        }
+
+        TransitionTable table(board, rules, dice);
+        if(!table.isValid()) {
+            cout << "The rules reject this board; no games are simulated." << endl;
+            return GameSimulator::simulate(table, players, 0, seed);
+        }
+        stats = GameSimulator::simulate(table, players, games, seed);
+
+        packed.clear();
+        packed.push_back(stats.games);
+        packed.push_back(stats.meanTurns);
+        packed.push_back(stats.stdDevTurns);
+        packed.insert(packed.end(), stats.seatWinRates.begin(), stats.seatWinRates.end());
+        cache.store(key, packed);
+        return stats;
+    }
+
+    void flush() {
+        cache.flush();
+    }
+};
+
+// ===================== Huge Boards (64-bit cells) =====================
+
+// Entity on a huge board; snake or ladder is implied by the direction of the move
+struct HugeEntityRecord {
+    int64_t start;
+    int64_t end;
+};
+
+// Board with 64-bit cell indices and sparse storage: memory is proportional to the entity count
+class HugeBoard {
+private:
+    int64_t cellCount;
+    vector<int64_t> entityStarts;  // sorted
+    vector<int64_t> entityEnds;    // parallel to entityStarts
+
+public:
+    HugeBoard(int64_t side) {
+        cellCount = side * side;
+    }
+
+    // Same contract as Board::addBoardEntities: all-or-nothing, merged into the sorted arrays
+    bool addEntities(vector<HugeEntityRecord> records) {
+        sort(records.begin(), records.end(),
+            [](const HugeEntityRecord& a, const HugeEntityRecord& b) { return a.start < b.start; });
+
+        for(size_t i = 0; i < records.size(); i++) {
+            HugeEntityRecord& record = records[i];
+            if(record.start < 1 || record.start >= cellCount || record.end < 1 || record.end > cellCount || record.end == record.start) {
+                cout << "Invalid entity " << record.start << " -> " << record.end << "." << endl;
+                return false;
+            }
+            if((i > 0 && records[i - 1].start == record.start) || hasEntity(record.start)) {
+                cout << "Duplicate entity start at cell " << record.start << "." << endl;
+                return false;
+            }
+        }
+
+        vector<int64_t> starts, ends;
+        starts.reserve(entityStarts.size() + records.size());
+        ends.reserve(entityStarts.size() + records.size());
+        size_t i = 0, j = 0;
+        while(i < entityStarts.size() || j < records.size()) {
+            if(j == records.size() || (i < entityStarts.size() && entityStarts[i] < records[j].start)) {
+                starts.push_back(entityStarts[i]);
+                ends.push_back(entityEnds[i]);
+                i++;
+            }
+            else {
+                starts.push_back(records[j].start);
+                ends.push_back(records[j].end);
+                j++;
+            }
+        }
+        entityStarts.swap(starts);
+        entityEnds.swap(ends);
+        return true;
+    }
+
+    bool hasEntity(int64_t cell) {
+        return binary_search(entityStarts.begin(), entityStarts.end(), cell);
+    }
+
+    // Cell a player ends on after landing on cell
+    int64_t destination(int64_t cell) {
+        auto it = lower_bound(entityStarts.begin(), entityStarts.end(), cell);
+        if(it != entityStarts.end() && *it == cell) {
+            return entityEnds[it - entityStarts.begin()];
+        }
+        return cell;
+    }
+
+    int64_t getCellCount() {
+        return cellCount;
+    }
+
+    size_t getEntityCount() {
+        return entityStarts.size();
+    }
+
+    int64_t getEntityStart(size_t i) {
+        return entityStarts[i];
+    }
+
+    int64_t getEntityEnd(size_t i) {
+        return entityEnds[i];
+    }
+};
+
+// Procedural board - entities are a pure function of a keyed hash of (seed, cell), so nothing is stored.
+// Density and snake/ladder ratio match RandomBoardSetupStrategy for the chosen difficulty.
+class ProceduralBoard {
+private:
+    int64_t cellCount;
+    uint64_t boardSeed;
+    uint64_t entityThreshold;  // hash bits below this start an entity (10% of cells)
+    uint64_t snakeThreshold;   // kind bits below this make the entity a snake
+
+    static uint64_t hashCell(uint64_t seed, uint64_t cell) {
+        uint64_t z = seed ^ (cell * 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+public:
+    ProceduralBoard(int64_t side, RandomBoardSetupStrategy::Difficulty difficulty, uint64_t seed) {
+        cellCount = side * side;
+        boardSeed = seed;
+        entityThreshold = (uint64_t)(0.1 * 4294967296.0);
+        snakeThreshold = (uint64_t)(RandomBoardSetupStrategy::snakeProbabilityFor(difficulty) * 1048576.0);
+    }
+
+    // Cell a player ends on after landing on cell. Written with selects rather than branches
+    // so batched lookups vectorize.
+    int64_t destination(int64_t cell) {
+        uint64_t h = hashCell(boardSeed, (uint64_t)cell);
+        uint64_t h2 = hashCell(~boardSeed, (uint64_t)cell);
+
+        bool isEntity = (h & 0xFFFFFFFFULL) < entityThreshold && cell >= 1 && cell < cellCount;
+        bool wantsSnake = ((h >> 32) & 0xFFFFF) < snakeThreshold;
+        bool snakeFits = cell >= 10;
+        bool ladderFits = cell <= cellCount - 10;
+        // Same fallback as the random strategies: a kind that does not fit flips to the other kind
+        bool isSnake = (wantsSnake && snakeFits) || !ladderFits;
+
+        double u = (h2 >> 11) * (1.0 / 9007199254740992.0);  // [0, 1)
+        int64_t snakeEnd = 1 + (int64_t)(u * (double)(cell - 1));
+        int64_t ladderEnd = cell + 1 + (int64_t)(u * (double)(cellCount - 1 - cell));
+        int64_t target = isSnake ? snakeEnd : ladderEnd;
+
+        return isEntity ? target : cell;
+    }
+
+    void destinationBatch(const int64_t* cells, int64_t* destinations, size_t count) {
+        for(size_t i = 0; i < count; i++) {
+            destinations[i] = destination(cells[i]);
+        }
+    }
+
+    bool hasEntity(int64_t cell) {
+        return destination(cell) != cell;
+    }
+
+    int64_t getCellCount() {
+        return cellCount;
+    }
+};
+
+// Seeded parallel generation with RandomBoardSetupStrategy's density and difficulty ratios
+class HugeBoardGenerator {
+public:
+    static bool generate(HugeBoard& board, RandomBoardSetupStrategy::Difficulty difficulty, uint64_t seed, int threads = 0) {
+        if(board.getCellCount() <= 10) {
+            cout << "Board is too small for random snakes and ladders." << endl;
+            return false;
+        }
+
+        int threadCount = WorkerThreads::resolve(threads);
+        vector<HugeEntityRecord> records = RandomStripeGenerator::generate<HugeEntityRecord>(
+            board.getCellCount(), RandomBoardSetupStrategy::snakeProbabilityFor(difficulty), seed, threadCount,
+            [](int64_t start, int64_t end, bool) {
+                HugeEntityRecord record;
+                record.start = start;
+                record.end = end;
+                return record;
+            });
+        return board.addEntities(records);
+    }
+};
+
+// Headless games on any board exposing getCellCount() and destination(cell) with 64-bit cells.
+// Standard rules: exact roll needed to finish.
+template <typename BoardT>
+class HugeBoardSimulator {
+public:
+    static const int64_t maxRounds = 10000000;
+
+    static SimulationStats simulate(BoardT& board, int players, int games, uint64_t seed, int faces = 6) {
+        RollBuffer dice(DiceDistribution::fair(faces), seed);
+        int64_t cells = board.getCellCount();
+
+        SimulationStats stats;
+        stats.games = games;
+        stats.seatWinRates.assign(players, 0.0);
+
+        vector<int64_t> positions(players);
+        double sum = 0.0, sumSquares = 0.0;
+        int unfinished = 0;
+
+        for(int game = 0; game < games; game++) {
+            fill(positions.begin(), positions.end(), 0);
+            int winnerSeat = -1;
+            int64_t round = 0;
+
+            // Same cap as GameSimulator so a board whose end cannot be reached does not hang
+            while(winnerSeat < 0 && round < maxRounds) {
+                round++;
+                for(int seat = 0; seat < players; seat++) {
+                    int64_t target = positions[seat] + dice.next();
+                    if(target <= cells) {
+                        positions[seat] = board.destination(target);
+                    }
+                    if(positions[seat] == cells) {
+                        winnerSeat = seat;
+                        break;
+                    }
+                }
+            }
+
+            if(winnerSeat >= 0) {
+                stats.seatWinRates[winnerSeat] += 1.0;
+            }
+            else {
+                unfinished++;
+            }
+            sum += (double)round;
+            sumSquares += (double)round * round;
+        }
+
+        if(unfinished > 0) {
+            cout << unfinished << " of " << games << " games were stopped after " << maxRounds
+                 << " rounds without a winner; the final cell may be unreachable." << endl;
+        }
+        stats.meanTurns = games > 0 ? sum / games : 0.0;
+        stats.stdDevTurns = games > 0 ? sqrt(max(0.0, sumSquares / games - stats.meanTurns * stats.meanTurns)) : 0.0;
+        for(auto& rate : stats.seatWinRates) {
+            rate /= max(1, games);
+        }
+        return stats;
+    }
+};
+
+// Exact expected turns from the start of a huge board in O(entities) memory.
+// Each sweep walks the board from the end down keeping only a window of the next `faces` values,
+// plus the values at entity destinations. Ladder destinations are ahead of the sweep and already
+// current; snake destinations are behind it, so sweeps repeat until those values settle.
+class HugeBoardAnalyzer {
+public:
+    static bool expectedTurnsFromStart(HugeBoard& board, double& result, int faces = 6, double tolerance = 1e-9, int maxSweeps = 10000) {
+        int64_t cells = board.getCellCount();
+        size_t entityCount = board.getEntityCount();
+        double faceProbability = 1.0 / faces;
+
+        // Distinct destination cells, sorted, and each entity's slot among them
+        vector<int64_t> destinations(entityCount);
+        for(size_t i = 0; i < entityCount; i++) {
+            destinations[i] = board.getEntityEnd(i);
+        }
+        sort(destinations.begin(), destinations.end());
+        destinations.erase(unique(destinations.begin(), destinations.end()), destinations.end());
+
+        vector<size_t> destinationSlot(entityCount);
+        for(size_t i = 0; i < entityCount; i++) {
+            destinationSlot[i] = lower_bound(destinations.begin(), destinations.end(), board.getEntityEnd(i)) - destinations.begin();
+        }
+
+        // Initial guess: a plain board needs about (cells - c) / average roll turns
+        double averageRoll = (faces + 1) / 2.0;
+        vector<double> destinationValues(destinations.size());
+        for(size_t i = 0; i < destinations.size(); i++) {
+            destinationValues[i] = (cells - destinations[i]) / averageRoll;
+        }
+
+        // window[(c) % faces] holds the value of landing on cell c, for the `faces` cells ahead of the sweep
+        vector<double> window(faces, 0.0);
+        double previousStart = -1.0;
+
+        // Sweeps are an affine map on the destination values whose slowest mode decays by a factor
+        // close to 1 on snake-heavy boards; SweepExtrapolator removes that mode once it is steady
+        vector<double> sweepStartValues, delta(destinations.size());
+        SweepExtrapolator extrapolator;
+
+        for(int sweep = 0; sweep < maxSweeps; sweep++) {
+            double maxChange = 0.0;
+            sweepStartValues = destinationValues;
+            size_t entity = entityCount;           // entities with start > current cell are behind us
+            size_t destination = destinations.size();
+            fill(window.begin(), window.end(), 0.0);
+
+            double value = 0.0;
+            for(int64_t cell = cells; cell >= 0; cell--) {
+                if(cell == cells) {
+                    value = 0.0;
+                }
+                else {
+                    double sum = 1.0;
+                    int validFaces = 0;
+                    for(int face = 1; face <= faces && cell + face <= cells; face++) {
+                        sum += faceProbability * window[(cell + face) % faces];
+                        validFaces++;
+                    }
+                    value = sum / (validFaces * faceProbability);
+                }
+
+                while(destination > 0 && destinations[destination - 1] >= cell) {
+                    destination--;
+                    if(destinations[destination] == cell) {
+                        maxChange = max(maxChange, fabs(destinationValues[destination] - value));
+                        destinationValues[destination] = value;
+                    }
+                }
+
+                // Value of landing here: follow the entity if one starts on this cell
+                double landing = value;
+                while(entity > 0 && board.getEntityStart(entity - 1) > cell) entity--;
+                if(entity > 0 && board.getEntityStart(entity - 1) == cell) {
+                    landing = destinationValues[destinationSlot[entity - 1]];
+                }
+                window[cell % faces] = landing;
+            }
+
+            maxChange = max(maxChange, fabs(value - previousStart));
+            previousStart = value;
+            if(maxChange < tolerance * max(1.0, value)) {
+                result = value;
+                return true;
+            }
+
+            // The start value is derived from the destination values, so a jump is judged on those alone
+            double destinationChange = 0.0;
+            for(size_t i = 0; i < delta.size(); i++) {
+                delta[i] = destinationValues[i] - sweepStartValues[i];
+                destinationChange = max(destinationChange, fabs(delta[i]));
+            }
+            extrapolator.afterSweep(delta, destinationChange, [&](size_t i) -> double& { return destinationValues[i]; });
+        }
+
+        cout << "Expected turns did not converge; the final cell may be unreachable." << endl;
+        return false;
+    }
+};
+
+// Fixed-size buffer in anonymous memory or in a file mapped into memory, for solver state larger
+// than RAM. File-backed buffers take page-cache hints so a sequential pass keeps only a few chunks
+// resident: read a range ahead before it is needed, and release it once done. Releasing starts
+// write-back of the range's dirty pages and drops the pages that are already clean; the rest
+// become clean, and cheap to reclaim, as the write-back finishes. Anonymous buffers ignore the hints.
+#ifdef HAS_POSIX_MAPPING
+class MappedBuffer {
+private:
+    void* address = nullptr;
+    size_t bytes = 0;
+    int descriptor = -1;
+    string path;
+    bool keepFile = false;
+
+    void pageRange(size_t offset, size_t length, size_t& first, size_t& count) {
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t end = min(bytes, offset + length);
+        first = offset / page * page;
+        count = end > first ? end - first : 0;
+    }
+
+public:
+    MappedBuffer() {}
+    MappedBuffer(const MappedBuffer&) = delete;
+    MappedBuffer& operator=(const MappedBuffer&) = delete;
+
+    // An empty path maps anonymous memory; otherwise the file is created (or truncated) at `bytes`
+    // bytes, and removed again on destruction unless keepFile is set
+    bool open(size_t size, const string& filePath = "", bool keep = false) {
+        bytes = size;
+        path = filePath;
+        keepFile = keep;
+        if(bytes == 0) {
+            return true;
+        }
+        if(path.empty()) {
+            address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        }
+        else {
+            descriptor = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+            if(descriptor < 0 || ftruncate(descriptor, (off_t)bytes) != 0) {
+                cout << "Cannot create " << bytes << " byte file " << path << "." << endl;
+                return false;
+            }
+            address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+        }
+        if(address == MAP_FAILED) {
+            address = nullptr;
+            cout << "Cannot map " << bytes << " bytes" << (path.empty() ? "" : " of " + path) << "." << endl;
+            return false;
+        }
+        return true;
+    }
+
+    ~MappedBuffer() {
+        if(address) {
+            munmap(address, bytes);
+        }
+        if(descriptor >= 0) {
+            close(descriptor);
+            if(!keepFile) {
+                unlink(path.c_str());
+            }
+        }
+    }
+
+    template <typename T>
+    T* as() {
+        return (T*)address;
+    }
+
+    void readAhead(size_t offset, size_t length) {
+        size_t first, count;
+        pageRange(offset, length, first, count);
+        if(descriptor >= 0 && count > 0) {
+            madvise((char*)address + first, count, MADV_WILLNEED);
+        }
+    }
+
+    void release(size_t offset, size_t length) {
+        size_t first, count;
+        pageRange(offset, length, first, count);
+        if(descriptor >= 0 && count > 0) {
+            msync((char*)address + first, count, MS_ASYNC);
+            madvise((char*)address + first, count, MADV_DONTNEED);
+#ifdef SYNC_FILE_RANGE_WRITE
+            // Linux tracks dirty shared pages itself and MS_ASYNC starts nothing; this does
+            sync_file_range(descriptor, (off64_t)first, (off64_t)count, SYNC_FILE_RANGE_WRITE);
+#endif
+#ifdef POSIX_FADV_DONTNEED
+            posix_fadvise(descriptor, (off_t)first, (off_t)count, POSIX_FADV_DONTNEED);
+#endif
+        }
+    }
+};
+#else
+// Without POSIX mappings every buffer lives on the heap, so streaming mode needs the memory it
+// would otherwise avoid; results are the same. A kept file is written out on destruction.
+class MappedBuffer {
+private:
+    char* address = nullptr;
+    size_t bytes = 0;
+    string path;
+    bool keepFile = false;
+
+public:
+    MappedBuffer() {}
+    MappedBuffer(const MappedBuffer&) = delete;
+    MappedBuffer& operator=(const MappedBuffer&) = delete;
+
+    bool open(size_t size, const string& filePath = "", bool keep = false) {
+        bytes = size;
+        path = filePath;
+        keepFile = keep && !path.empty();
+        if(keepFile && !ofstream(path, ios::binary | ios::trunc)) {
+            cout << "Cannot create " << bytes << " byte file " << path << "." << endl;
+            return false;
+        }
+        if(bytes == 0) {
+            return true;
+        }
+        address = new (nothrow) char[bytes]();
+        if(address == nullptr) {
+            cout << "Cannot allocate " << bytes << " bytes" << (path.empty() ? "" : " for " + path) << "." << endl;
+            return false;
+        }
+        return true;
+    }
+
+    ~MappedBuffer() {
+        if(keepFile && address) {
+            ofstream out(path, ios::binary | ios::trunc);
+            out.write(address, (streamsize)bytes);
+        }
+        delete[] address;
+    }
+
+    template <typename T>
+    T* as() {
+        return (T*)address;
+    }
+
+    void readAhead(size_t, size_t) {}
+
+    void release(size_t, size_t) {}
+};
+#endif
+
+// Exact expected turns for every cell of a huge board, on many cores.
+// The board is cut into fixed blocks of cells. Dice only move forward, so a block sees the blocks
+// above it only through the `faces` landing values just past its top (its window). A sweep takes
+// every entity destination's value as given, which makes a block's values affine in its window
+// with a linear part fixed by the board, computed once. A sweep of the whole board is then every
+// block swept in parallel with an empty window, the exact windows chained down from the top in
+// O(blocks * faces^2), and each block's window term added to the values at its destinations.
+// Snakes couple blocks across the whole board, so the destination values are solved with BiCGSTAB
+// around that sweep until one sweep would change none of them by more than tolerance * the largest.
+// Results depend on neither the thread count nor the block size.
+class ParallelHugeBoardAnalyzer {
+private:
+    // Reusable barrier: exactly one caller per phase gets true and runs the serial step, while the
+    // rest wait at the next barrier
+    class PhaseBarrier {
+    private:
+        mutex lock;
+        condition_variable released;
+        int threadCount;
+        int waiting = 0;
+        uint64_t generation = 0;
+
+    public:
+        PhaseBarrier(int threadCount) : threadCount(threadCount) {}
+
+        bool wait() {
+            unique_lock<mutex> guard(lock);
+            uint64_t arrivedIn = generation;
+            if(++waiting == threadCount) {
+                waiting = 0;
+                generation++;
+                released.notify_all();
+                return true;
+            }
+            released.wait(guard, [&]() { return generation != arrivedIn; });
+            return false;
+        }
+    };
+
+    struct Layout {
+        int64_t cells;
+        int faces;
+        int64_t blockCells;
+        int64_t blockCount;
+        const int64_t* destinations;        // distinct destination cells, sorted
+        const size_t* destinationSlot;      // per entity
+        vector<size_t> entityBegin;         // per block, plus one past the end
+        vector<size_t> slotBegin;           // per block, plus one past the end
+
+        int64_t blockLow(int64_t block) const {
+            return block * blockCells;
+        }
+
+        int64_t blockHigh(int64_t block) const {
+            return block == blockCount - 1 ? cells : (block + 1) * blockCells - 1;
+        }
+    };
+
+    // One sweep of a block from its top cell down. window[k] is the landing value of cell high + 1 + k;
+    // constant is 1 for a real sweep and 0 for the linear part alone. Destination values come from
+    // previous, or count as 0 when it is null. Writes the values at the block's own destinations to fresh, its lowest
+    // `faces` landing values to bottom, the value at cell 0 to start and, if given, every value to perCell.
+    static void sweepBlock(HugeBoard& board, const Layout& layout, int64_t block, const double* window,
+                           double constant, const double* previous, double* fresh, double* bottom,
+                           double* start, double* perCell) {
+        int64_t cells = layout.cells;
+        int faces = layout.faces;
+        int64_t low = layout.blockLow(block);
+        int64_t high = layout.blockHigh(block);
+
+        // Each landing value is stored twice, so the `faces` values ahead of the sweep are always
+        // the contiguous run ring[position + 1 .. position + faces]
+        vector<double> ring(2 * faces, 0.0);
+        int position = 0;
+        for(int k = 0; k < faces; k++) {
+            ring[(k + 1) % faces] = ring[(k + 1) % faces + faces] = window[k];
+        }
+
+        size_t entity = layout.entityBegin[block + 1];
+        size_t slot = layout.slotBegin[block + 1];
+        for(int64_t cell = high; cell >= low; cell--) {
+            double value = 0.0;
+            if(cell < cells) {
+                int validFaces = (int)min<int64_t>(faces, cells - cell);
+                double sum = constant * faces;
+                for(int face = 1; face <= validFaces; face++) {
+                    sum += ring[position + face];
+                }
+                value = sum / validFaces;
+            }
+            if(perCell) {
+                perCell[cell] = value;
+            }
+            if(slot > layout.slotBegin[block] && layout.destinations[slot - 1] == cell) {
+                slot--;
+                fresh[slot] = value;
+            }
+            if(cell == 0) {
+                *start = value;
+            }
+
+            double landing = value;
+            if(entity > layout.entityBegin[block] && board.getEntityStart(entity - 1) == cell) {
+                entity--;
+                landing = previous ? previous[layout.destinationSlot[entity]] : 0.0;
+            }
+            ring[position] = ring[position + faces] = landing;
+            position = position == 0 ? faces - 1 : position - 1;
+            if(cell < low + faces) {
+                bottom[cell - low] = landing;
+            }
+        }
+    }
+
+    // An array a pass reads or writes block by block: each block's slice is read ahead a few
+    // blocks early and dropped once the block is done
+    struct Stream {
+        MappedBuffer* buffer;
+        const vector<size_t>* begins;   // per-block first index, or null for per-cell arrays
+        size_t itemBytes;
+    };
+
+    static const int readAheadBlocks = 4;
+
+    static bool solve(HugeBoard& board, double& result, double* perCell, int threads, double tolerance,
+                      int maxIterations, int faces, int64_t blockCells, const string& scratchDirectory,
+                      MappedBuffer* perCellFile) {
+        bool reportProgress = !scratchDirectory.empty();
+        auto scratchPath = [&](const string& name) {
+            return scratchDirectory.empty() ? string() : scratchDirectory + "/" + name;
+        };
+
+        Layout layout;
+        layout.cells = board.getCellCount();
+        layout.faces = faces;
+        layout.blockCells = max<int64_t>(blockCells, faces);
+        layout.blockCount = max<int64_t>(1, (layout.cells + 1) / layout.blockCells);
+        size_t entityCount = board.getEntityCount();
+
+        MappedBuffer destinationFile, slotFile;
+        if(!destinationFile.open(entityCount * sizeof(int64_t), scratchPath("destinations.bin")) ||
+           !slotFile.open(entityCount * sizeof(size_t), scratchPath("slots.bin"))) {
+            return false;
+        }
+        int64_t* destinations = destinationFile.as<int64_t>();
+        size_t* destinationSlot = slotFile.as<size_t>();
+        for(size_t i = 0; i < entityCount; i++) {
+            destinations[i] = board.getEntityEnd(i);
+        }
+        sort(destinations, destinations + entityCount);
+        size_t slotCount = unique(destinations, destinations + entityCount) - destinations;
+        for(size_t i = 0; i < entityCount; i++) {
+            destinationSlot[i] = lower_bound(destinations, destinations + slotCount, board.getEntityEnd(i)) - destinations;
+        }
+        layout.destinations = destinations;
+        layout.destinationSlot = destinationSlot;
+
+        // Entities and destinations are sorted, so each block owns a contiguous range of both
+        int64_t blockCount = layout.blockCount;
+        layout.entityBegin.resize(blockCount + 1);
+        layout.slotBegin.resize(blockCount + 1);
+        size_t entity = 0, slot = 0;
+        for(int64_t block = 0; block <= blockCount; block++) {
+            int64_t low = block < blockCount ? layout.blockLow(block) : layout.cells + 1;
+            while(entity < entityCount && board.getEntityStart(entity) < low) entity++;
+            while(slot < slotCount && destinations[slot] < low) slot++;
+            layout.entityBegin[block] = entity;
+            layout.slotBegin[block] = slot;
+        }
+
+        // Solver state, one value per destination. values, direction and step are read at random
+        // (every entity looks up its destination); everything else is streamed block by block.
+        // destinationMap is the linear part of each block from its window to its destinations.
+        const int vectorCount = 7;
+        const char* vectorNames[vectorCount] = {"values", "residual", "shadow", "direction", "direction-image", "step", "step-image"};
+        MappedBuffer vectorFiles[vectorCount], destinationMapFile;
+        for(int i = 0; i < vectorCount; i++) {
+            if(!vectorFiles[i].open(slotCount * sizeof(double), scratchPath(string(vectorNames[i]) + ".bin"))) {
+                return false;
+            }
+        }
+        if(!destinationMapFile.open(slotCount * faces * sizeof(double), scratchPath("destination-map.bin"))) {
+            return false;
+        }
+        double* values = vectorFiles[0].as<double>();
+        double* residual = vectorFiles[1].as<double>();
+        double* shadow = vectorFiles[2].as<double>();
+        double* direction = vectorFiles[3].as<double>();
+        double* directionImage = vectorFiles[4].as<double>();
+        double* step = vectorFiles[5].as<double>();
+        double* stepImage = vectorFiles[6].as<double>();
+        double* destinationMap = destinationMapFile.as<double>();
+
+        Stream entitySlots = {&slotFile, &layout.entityBegin, sizeof(size_t)};
+        Stream destinationCells = {&destinationFile, &layout.slotBegin, sizeof(int64_t)};
+        Stream mapStream = {&destinationMapFile, &layout.slotBegin, faces * sizeof(double)};
+        auto slotStream = [&](int index) {
+            Stream stream = {&vectorFiles[index], &layout.slotBegin, sizeof(double)};
+            return stream;
+        };
+        Stream cellStream = {perCellFile, nullptr, sizeof(double)};
+
+        // Initial guess: a plain board needs about (cells - c) / average roll turns
+        double averageRoll = (faces + 1) / 2.0;
+        for(size_t i = 0; i < slotCount; i++) {
+            values[i] = (layout.cells - destinations[i]) / averageRoll;
+        }
+
+        // Linear part of each block's window: windowMap maps it to the block's bottom landing values
+        vector<double> windowMap(blockCount * faces * faces);
+        vector<double> startMap(faces), bottom(blockCount * faces), windows(blockCount * faces, 0.0);
+        double startConstant = 0.0;
+
+        int threadCount = (int)min<int64_t>(WorkerThreads::resolve(threads), blockCount);
+        PhaseBarrier barrier(threadCount);
+        atomic<int64_t> nextBlock(0);
+        atomic<int> nextThread(0);
+        int64_t finishedBlocks = 0;
+        mutex progressLock;
+        bool converged = false;
+        if(reportProgress) {
+            cout << "Solving " << layout.cells << " cells in " << blockCount << " blocks, " << slotCount
+                 << " destinations, on " << threadCount << " threads." << endl;
+        }
+
+        // Per-block partial sums, alternating between two buffers so one reduction's buffer is
+        // never overwritten while a slow thread still reads it
+        vector<double> blockSums(2 * blockCount * 4);
+
+        auto forEachBlock = [&](initializer_list<Stream> streams, auto&& body) {
+            auto slice = [&](const Stream& stream, int64_t block, bool ahead) {
+                if(!stream.buffer || block >= blockCount) {
+                    return;
+                }
+                int64_t last = ahead ? min(blockCount - 1, block + readAheadBlocks) : block;
+                size_t first = stream.begins ? (*stream.begins)[block] : (size_t)layout.blockLow(block);
+                size_t end = stream.begins ? (*stream.begins)[last + 1] : (size_t)layout.blockHigh(last) + 1;
+                if(ahead) {
+                    stream.buffer->readAhead(first * stream.itemBytes, (end - first) * stream.itemBytes);
+                }
+                else {
+                    stream.buffer->release(first * stream.itemBytes, (end - first) * stream.itemBytes);
+                }
+            };
+            for(int64_t block = nextBlock++; block < blockCount; block = nextBlock++) {
+                for(const Stream& stream : streams) {
+                    slice(stream, block + 1, true);
+                }
+                body(block);
+                for(const Stream& stream : streams) {
+                    slice(stream, block, false);
+                }
+            }
+            if(barrier.wait()) {
+                nextBlock = 0;
+            }
+            barrier.wait();
+        };
+
+        // Windows are exact once every block's bottom values are known: chain them down from the top
+        auto chainWindows = [&]() {
+            for(int64_t block = blockCount - 2; block >= 0; block--) {
+                const double* above = &windows[(block + 1) * faces];
+                const double* map = &windowMap[(block + 1) * faces * faces];
+                for(int row = 0; row < faces; row++) {
+                    double value = bottom[(block + 1) * faces + row];
+                    for(int k = 0; k < faces; k++) {
+                        value += map[row * faces + k] * above[k];
+                    }
+                    windows[block * faces + row] = value;
+                }
+            }
+        };
+
+        auto worker = [&]() {
+            vector<double> unit(faces), column(faces), empty(faces, 0.0);
+            double unused = 0.0;
+            int reductions = 0;
+            bool reporter = reportProgress && nextThread++ == 0;
+
+            forEachBlock({entitySlots, destinationCells, slotStream(1), mapStream}, [&](int64_t block) {
+                for(int k = 0; k < faces; k++) {
+                    fill(unit.begin(), unit.end(), 0.0);
+                    unit[k] = 1.0;
+                    sweepBlock(board, layout, block, unit.data(), 0.0, nullptr, residual, column.data(),
+                               block == 0 ? &startMap[k] : &unused, nullptr);
+                    for(int row = 0; row < faces; row++) {
+                        windowMap[(block * faces + row) * faces + k] = column[row];
+                    }
+                    for(size_t s = layout.slotBegin[block]; s < layout.slotBegin[block + 1]; s++) {
+                        destinationMap[s * faces + k] = residual[s];
+                    }
+                }
+            });
+
+            // One iteration of the block sweep: output = constant * (values of an empty board) + G * input,
+            // where G is the linear map from destination values to the values they produce
+            auto sweepAll = [&](const double* input, double constant, double* output, const Stream& outputStream) {
+                forEachBlock({entitySlots, destinationCells, outputStream}, [&](int64_t block) {
+                    sweepBlock(board, layout, block, empty.data(), constant, input, output, &bottom[block * faces],
+                               block == 0 ? &startConstant : &unused, nullptr);
+                });
+                if(barrier.wait()) {
+                    chainWindows();
+                }
+                barrier.wait();
+                forEachBlock({mapStream, outputStream}, [&](int64_t block) {
+                    const double* window = &windows[block * faces];
+                    for(size_t s = layout.slotBegin[block]; s < layout.slotBegin[block + 1]; s++) {
+                        for(int k = 0; k < faces; k++) {
+                            output[s] += destinationMap[s * faces + k] * window[k];
+                        }
+                    }
+                });
+            };
+
+            // Runs body(slot, sums) over every slot. sums[0] and sums[1] are sums, sums[2] and sums[3]
+            // maxima; blocks are combined in block order so every thread count gives the same totals
+            auto reduce = [&](initializer_list<Stream> streams, auto&& body) {
+                double* partial = &blockSums[(reductions++ % 2) * blockCount * 4];
+                forEachBlock(streams, [&](int64_t block) {
+                    double sums[4] = {0.0, 0.0, 0.0, 0.0};
+                    for(size_t s = layout.slotBegin[block]; s < layout.slotBegin[block + 1]; s++) {
+                        body(s, sums);
+                    }
+                    for(int j = 0; j < 4; j++) {
+                        partial[block * 4 + j] = sums[j];
+                    }
+                });
+                array<double, 4> totals = {0.0, 0.0, 0.0, 0.0};
+                for(int64_t block = 0; block < blockCount; block++) {
+                    totals[0] += partial[block * 4];
+                    totals[1] += partial[block * 4 + 1];
+                    totals[2] = max(totals[2], partial[block * 4 + 2]);
+                    totals[3] = max(totals[3], partial[block * 4 + 3]);
                 }
-            }
-            
-            // Add ladders
-            int laddersAdded = 0;
-            while(laddersAdded < ladderCount) {
-                int startIdx = rand() % (totalCells - 10) + 1;
-                int endIdx = rand() % (totalCells - startIdx) + startIdx + 1;
-                
-                if(board->canAddEntity(startIdx) && endIdx < totalCells) {
-                    board->addBoardEntity(new Ladder(startIdx, endIdx));
-                    laddersAdded++;
+                return totals;
+            };
+
+            // The exact values solve (I - G) x = c. Sweeping alone converges slowly on snake-heavy
+            // boards, so the system is solved by BiCGSTAB with one block sweep per operator product.
+            // sums[2] tracks the largest residual and sums[3] the largest value, for the stopping test.
+            auto applyOperator = [&](const double* input, double* output, const Stream& outputStream) {
+                sweepAll(input, 0.0, output, outputStream);
+                forEachBlock({outputStream}, [&](int64_t block) {
+                    for(size_t s = layout.slotBegin[block]; s < layout.slotBegin[block + 1]; s++) {
+                        output[s] = input[s] - output[s];
+                    }
+                });
+            };
+            auto residualSmall = [&](double maxResidual, double maxValue) {
+                return maxResidual < tolerance * max(1.0, maxValue);
+            };
+
+            // The residual BiCGSTAB updates drifts from the true one, so convergence is confirmed by a
+            // fresh sweep and the method restarts from there if that residual is still too large
+            double rho = 1.0, alpha = 1.0, omega = 1.0;
+            auto restart = [&]() {
+                sweepAll(values, 1.0, residual, slotStream(1));
+                array<double, 4> totals = reduce({slotStream(1), slotStream(2), slotStream(4)}, [&](size_t s, double* sums) {
+                    residual[s] -= values[s];
+                    shadow[s] = residual[s];
+                    direction[s] = directionImage[s] = 0.0;
+                    sums[3] = max(sums[3], fabs(values[s]));
+                    sums[2] = max(sums[2], fabs(residual[s]));
+                });
+                rho = alpha = omega = 1.0;
+                return residualSmall(totals[2], totals[3]);
+            };
+            bool done = restart();
+
+            for(int iteration = 0; iteration < maxIterations && !done; iteration++) {
+                double rhoNext = reduce({slotStream(1), slotStream(2)}, [&](size_t s, double* sums) { sums[0] += shadow[s] * residual[s]; })[0];
+                if(rhoNext == 0.0 || omega == 0.0) {
+                    // Breakdown: restart with the current residual as the shadow
+                    done = restart();
+                    if(done) {
+                        break;
+                    }
+                    rhoNext = reduce({slotStream(1)}, [&](size_t s, double* sums) { sums[0] += residual[s] * residual[s]; })[0];
                 }
-            }
-        } 
-        else {
-            // User-defined positions
-            for(auto& pos : snakePlacements) {
-                if(board->canAddEntity(pos.first)) {
-                    board->addBoardEntity(new Snake(pos.first, pos.second));
+                double beta = (rhoNext / rho) * (alpha / omega);
+                rho = rhoNext;
+                reduce({slotStream(1), slotStream(4)}, [&](size_t s, double*) {
+                    direction[s] = residual[s] + beta * (direction[s] - omega * directionImage[s]);
+                });
+
+                applyOperator(direction, directionImage, slotStream(4));
+                double shadowImage = reduce({slotStream(2), slotStream(4)}, [&](size_t s, double* sums) { sums[0] += shadow[s] * directionImage[s]; })[0];
+                alpha = shadowImage != 0.0 ? rho / shadowImage : 0.0;
+                array<double, 4> totals = reduce({slotStream(1), slotStream(4)}, [&](size_t s, double* sums) {
+                    step[s] = residual[s] - alpha * directionImage[s];
+                    sums[2] = max(sums[2], fabs(step[s]));
+                });
+                if(residualSmall(totals[2], 0.0) && alpha != 0.0) {
+                    reduce({}, [&](size_t s, double*) { values[s] += alpha * direction[s]; });
+                    omega = 0.0;  // the next iteration restarts, confirming or resuming from the true residual
+                    continue;
+                }
+
+                applyOperator(step, stepImage, slotStream(6));
+                totals = reduce({slotStream(6)}, [&](size_t s, double* sums) {
+                    sums[0] += stepImage[s] * step[s];
+                    sums[1] += stepImage[s] * stepImage[s];
+                });
+                omega = totals[1] > 0.0 ? totals[0] / totals[1] : 0.0;
+                totals = reduce({slotStream(1), slotStream(6)}, [&](size_t s, double* sums) {
+                    values[s] += alpha * direction[s] + omega * step[s];
+                    residual[s] = step[s] - omega * stepImage[s];
+                    sums[3] = max(sums[3], fabs(values[s]));
+                    sums[2] = max(sums[2], fabs(residual[s]));
+                });
+                if(reporter) {
+                    cout << "Iteration " << iteration + 1 << ": largest residual " << totals[2] << ", target "
+                         << tolerance * max(1.0, totals[3]) << endl;
+                }
+                if(residualSmall(totals[2], totals[3])) {
+                    done = restart();
                 }
             }
-            
-            for(auto& pos : ladderPlacements) {
-                if(board->canAddEntity(pos.first)) {
-                    board->addBoardEntity(new Ladder(pos.first, pos.second));
+
+            // Final pass with the solved destination values: exact windows, the start value and,
+            // if asked, every cell's value
+            if(done) {
+                sweepAll(values, 1.0, residual, slotStream(1));
+                if(perCell) {
+                    forEachBlock({entitySlots, destinationCells, slotStream(1), cellStream}, [&](int64_t block) {
+                        sweepBlock(board, layout, block, &windows[block * faces], 1.0, values, residual,
+                                   column.data(), &unused, perCell);
+                        if(reportProgress) {
+                            lock_guard<mutex> guard(progressLock);
+                            finishedBlocks++;
+                            if(finishedBlocks * 10 / blockCount != (finishedBlocks - 1) * 10 / blockCount) {
+                                cout << "Wrote cell values for " << finishedBlocks << " of " << blockCount << " blocks." << endl;
+                            }
+                        }
+                    });
+                }
+                if(barrier.wait()) {
+                    converged = true;
+                    for(int k = 0; k < faces; k++) {
+                        startConstant += startMap[k] * windows[k];
+                    }
                 }
+                barrier.wait();
             }
+        };
+        WorkerThreads::run(threadCount, worker);
+
+        if(!converged) {
+            cout << "Expected turns did not converge; the final cell may be unreachable." << endl;
+            return false;
         }
+        result = startConstant;
+        return true;
     }
-};
 
-// Standard Board Strategy - Traditional Snake & Ladder positions
-class StandardBoardSetupStrategy : public BoardSetupStrategy {
 public:
-    void setupBoard(Board* board) override {
-        // Only works for 10x10 board (100 cells)
-        if(board->getBoardSize() != 100) {
-            cout << "Standard configuration supports only a 10x10 board (100 cells)." << endl;
-            return;
+    static const int64_t defaultBlockCells = 1 << 16;
+
+    static bool expectedTurnsFromStart(HugeBoard& board, double& result, int threads = 0, double tolerance = 1e-12,
+                                       int maxIterations = 10000, int faces = 6, int64_t blockCells = defaultBlockCells) {
+        return solve(board, result, nullptr, threads, tolerance, maxIterations, faces, blockCells, "", nullptr);
+    }
+
+    // expected[c] is the expected number of turns to finish for a player standing on cell c
+    static bool expectedTurnsPerCell(HugeBoard& board, vector<double>& expected, int threads = 0, double tolerance = 1e-12,
+                                     int maxIterations = 10000, int faces = 6, int64_t blockCells = defaultBlockCells) {
+        double start = 0.0;
+        expected.assign(board.getCellCount() + 1, 0.0);
+        return solve(board, start, expected.data(), threads, tolerance, maxIterations, faces, blockCells, "", nullptr);
+    }
+
+    // Streaming mode for boards whose solver state does not fit in memory. Every array of the solve
+    // lives in a file under scratchDirectory and is walked in block order with read-ahead, so I/O is
+    // sequential apart from the values looked up at entity destinations. The per-cell values are
+    // written to outputPath as cells + 1 native doubles; progress is reported on cout.
+    static bool expectedTurnsToFile(HugeBoard& board, const string& outputPath, const string& scratchDirectory,
+                                    double& result, int threads = 0, double tolerance = 1e-12, int maxIterations = 10000,
+                                    int faces = 6, int64_t blockCells = defaultBlockCells) {
+        MappedBuffer output;
+        if(!output.open((board.getCellCount() + 1) * sizeof(double), outputPath, true)) {
+            return false;
         }
-        
-        // Standard snake positions (based on traditional board)
-        board->addBoardEntity(new Snake(99, 54));
-        board->addBoardEntity(new Snake(95, 75));
-        board->addBoardEntity(new Snake(92, 88));
-        board->addBoardEntity(new Snake(89, 68));
-        board->addBoardEntity(new Snake(74, 53));
-        board->addBoardEntity(new Snake(64, 60));
-        board->addBoardEntity(new Snake(62, 19));
-        board->addBoardEntity(new Snake(49, 11));
-        board->addBoardEntity(new Snake(46, 25));
-        board->addBoardEntity(new Snake(16, 6));
-        
-        // Standard ladder positions
-        board->addBoardEntity(new Ladder(2, 38));
-        board->addBoardEntity(new Ladder(7, 14));
-        board->addBoardEntity(new Ladder(8, 31));
-        board->addBoardEntity(new Ladder(15, 26));
-        board->addBoardEntity(new Ladder(21, 42));
-        board->addBoardEntity(new Ladder(28, 84));
-        board->addBoardEntity(new Ladder(36, 44));
-        board->addBoardEntity(new Ladder(51, 67));
-        board->addBoardEntity(new Ladder(71, 91));
-        board->addBoardEntity(new Ladder(78, 98));
-        board->addBoardEntity(new Ladder(87, 94));
+        return solve(board, result, output.as<double>(), threads, tolerance, maxIterations, faces, blockCells,
+                     scratchDirectory, &output);
     }
 };
 
-// Now defining setupBoard for Board class
-void Board::setupBoard(BoardSetupStrategy* strategy) {
-    strategy->setupBoard(this);
-}
-
-// Player class
-class SnakeAndLadderPlayer {
+// Cross-checks of the fast analysis paths against the linear solver (run with --self-check)
+class AnalyzerSelfCheck {
 private:
-    int id;
-    string playerName;
-    int currentPosition;
-    int winCount;
-    
-public:
-    SnakeAndLadderPlayer(int playerId, string n) {
-        this->id = playerId;
-        playerName = n;
-        currentPosition = 0;
-        winCount = 0;
-    }
-    
-    // Getters and Setters
-    string getName() { 
-        return playerName;
-    }
-    int getPosition() { 
-        return currentPosition; 
-    }
-    void setPosition(int pos) { 
-        currentPosition = pos; 
-    }
-    int getScore() { 
-        return winCount;
+    static bool meanMatchesSolver(const string& name, Board* board, SnakeAndLadderRules* rules) {
+        TransitionTable table(board, rules, 6);
+        vector<double> expected;
+        if(!BoardAnalyzer::solveExpectedTurns(table, expected, 1e-12)) {
+            cout << name << ": solver failed" << endl;
+            return false;
+        }
+        double exact = expected[table.stateOf(0)];
+        double mean = GameLengthAnalyzer::singlePlayer(table).mean();
+        bool ok = fabs(mean - exact) <= 1e-6 * exact;
+        cout << name << ": distribution mean " << mean << ", solver " << exact << (ok ? "  ok" : "  MISMATCH") << endl;
+        return ok;
     }
-    void incrementScore() { 
-        winCount++; 
+
+    // HARD board from HugeBoardGenerator, solved by both sweeping solvers and by DifficultyCalibration's
+    // elimination
+    static bool sweepMatchesElimination(int side, uint64_t seed) {
+        HugeBoard hugeBoard(side);
+        if(!HugeBoardGenerator::generate(hugeBoard, RandomBoardSetupStrategy::HARD, seed, 2)) {
+            return false;
+        }
+        vector<BoardEntityRecord> records;
+        for(size_t i = 0; i < hugeBoard.getEntityCount(); i++) {
+            int start = (int)hugeBoard.getEntityStart(i), end = (int)hugeBoard.getEntityEnd(i);
+            records.push_back({start, end, end < start});
+        }
+        double exact = DifficultyCalibration::expectedTurns(side * side, records);
+
+        Board board(side);
+        board.addBoardEntities(records);
+        StandardSnakeAndLadderRules standard;
+        TransitionTable table(&board, &standard, 6);
+        vector<double> expected;
+        bool solved = BoardAnalyzer::solveExpectedTurns(table, expected, 1e-12);
+        double swept = solved ? expected[table.stateOf(0)] : NAN;
+        double windowed = NAN;
+        bool windowSolved = HugeBoardAnalyzer::expectedTurnsFromStart(hugeBoard, windowed, 6, 1e-12);
+        bool ok = solved && fabs(swept - exact) <= 1e-6 * exact && windowSolved && fabs(windowed - exact) <= 1e-6 * exact;
+        cout << "HARD board, side " << side << ", seed " << seed << ": solver " << swept << ", huge-board sweep "
+             << windowed << ", elimination " << exact << (ok ? "  ok" : "  MISMATCH") << endl;
+        return ok;
     }
-};
 
-// Strategy Pattern for game rules
-class SnakeAndLadderRules {
 public:
-    virtual bool isValidMove(int currentPos, int diceValue, int boardSize) = 0;
-    virtual int calculateNewPosition(int currentPos, int diceValue, Board* board) = 0;
-    virtual bool checkWinCondition(int position, int boardSize) = 0;
-    virtual ~SnakeAndLadderRules() {}
+    static bool run() {
+        bool ok = true;
+
+        // A ladder ending on a snake head within the last six cells: blocked rolls from the
+        // ladder's foot region land on the snake and must be moved exactly once
+        Board chained(10);
+        chained.addBoardEntities({{80, 98, false}, {98, 50, true}});
+        StandardSnakeAndLadderRules standard;
+        ok = meanMatchesSolver("ladder onto snake head near the end", &chained, &standard) && ok;
+
+        Board standardBoard(10);
+        StandardBoardSetupStrategy standardSetup;
+        standardBoard.setupBoard(&standardSetup);
+        ok = meanMatchesSolver("standard board", &standardBoard, &standard) && ok;
+
+        // Snake-heavy boards whose slow mode once drove an unchecked extrapolation to -1e145
+        ok = sweepMatchesElimination(95, 5025) && ok;
+        ok = sweepMatchesElimination(121, 5027) && ok;
+        ok = sweepMatchesElimination(124, 1017) && ok;
+        return ok;
+    }
 };
 
-// Standard rules
-class StandardSnakeAndLadderRules : public SnakeAndLadderRules {
+// Batch solver against the scalar elimination on seeded random corpora (run with --bench-batch-solver)
+class BatchSolverBenchmark {
 public:
-    bool isValidMove(int currentPos, int diceValue, int boardSize) override {
-        return (currentPos + diceValue) <= boardSize;
-    }
-    
-    int calculateNewPosition(int currentPos, int diceValue, Board* board) override {
-        int newPos = currentPos + diceValue;
-        BoardEntity* entity = board->getEntity(newPos);
-        
-        if(entity != nullptr) {
-            return entity->getEnd();
+    static bool run(int boardsPerSide = 4096) {
+        int sides[] = {10, 20, 40};
+        bool ok = true;
+        cout << "side\tboards\tscalar boards/s\tbatch boards/s\tmax rel diff" << endl;
+        for(int side : sides) {
+            int cells = side * side;
+            vector<vector<BoardEntityRecord>> boards(boardsPerSide);
+            for(int b = 0; b < boardsPerSide; b++) {
+                double snakeProbability = RandomBoardSetupStrategy::snakeProbabilityFor((RandomBoardSetupStrategy::Difficulty)(b % 3));
+                boards[b] = RandomStripeGenerator::generate<BoardEntityRecord>(cells, snakeProbability, (uint64_t)side << 32 | b, 1,
+                    [](int start, int end, bool isSnake) { return BoardEntityRecord{start, end, isSnake}; });
+            }
+
+            auto begin = chrono::steady_clock::now();
+            vector<double> scalar(boardsPerSide);
+            for(int b = 0; b < boardsPerSide; b++) {
+                scalar[b] = DifficultyCalibration::expectedTurns(cells, boards[b]);
+            }
+            auto middle = chrono::steady_clock::now();
+            vector<double> batch = BatchBoardSolver::solve(cells, boards);
+            auto finish = chrono::steady_clock::now();
+
+            // Unfinishable boards must be INFINITY on both paths
+            double maxDiff = 0.0;
+            for(int b = 0; b < boardsPerSide; b++) {
+                if(isinf(scalar[b]) || isinf(batch[b])) {
+                    if(scalar[b] != batch[b]) maxDiff = INFINITY;
+                    continue;
+                }
+                maxDiff = max(maxDiff, fabs(batch[b] - scalar[b]) / scalar[b]);
+            }
+            double scalarSeconds = chrono::duration<double>(middle - begin).count();
+            double batchSeconds = chrono::duration<double>(finish - middle).count();
+            cout << side << "\t" << boardsPerSide << "\t" << boardsPerSide / scalarSeconds << "\t"
+                 << boardsPerSide / batchSeconds << "\t" << maxDiff << endl;
+            if(!(maxDiff <= 1e-9)) {
+                cout << "Batch results differ from DifficultyCalibration::expectedTurns." << endl;
+                ok = false;
+            }
         }
-        return newPos;
-    }
-    
-    bool checkWinCondition(int position, int boardSize) override {
-        return position == boardSize;
+        return ok;
     }
 };
 
-// Game class
-class SnakeAndLadderGame {
+// Lookup benchmark across board sizes and densities (run with --bench-index)
+class EntityLookupBenchmark {
 private:
-    Board* gameBoard;
-    Dice* gameDice;
-    deque<SnakeAndLadderPlayer*> turnQueue;
-    SnakeAndLadderRules* gameRules;
-    vector<IObserver*> subscriberList;
-    bool isGameOver;
-    
-public:
-    SnakeAndLadderGame(Board* b, Dice* d) {
-        gameBoard = b;
-        gameDice = d;
-        gameRules = new StandardSnakeAndLadderRules();
-        isGameOver = false;
-    }
-    
-    void addPlayer(SnakeAndLadderPlayer* player) {
-        turnQueue.push_back(player);
-    }
-    
-    void addObserver(IObserver* observer) {
-        subscriberList.push_back(observer);
-    }
+    static inline volatile long long sink = 0;
 
-    void notify(string msg) {
-        for(auto observer : subscriberList) {
-            observer->update(msg);
-        }
-    }
-    
-    void displayPlayerPositions() {
-        cout << "\n=== Current Player Positions ===" << endl;
-        for(auto player : turnQueue) {
-            cout << player->getName() << ": " << player->getPosition() << endl;
+    static double nanosPerLookup(EntityLookup& lookup, const vector<int>& queries) {
+        auto begin = chrono::steady_clock::now();
+        long long checksum = 0;
+        for(int round = 0; round < 4; round++) {
+            for(int query : queries) {
+                checksum += lookup.find(query);
+            }
         }
-        cout << "==============================" << endl;
+        auto finish = chrono::steady_clock::now();
+        sink = checksum;  // the lookups have an observable result, so they cannot be optimized away
+        return chrono::duration<double, nano>(finish - begin).count() / (4.0 * queries.size());
     }
     
-    void play() {
-        if(turnQueue.size() < 2) {
-            cout << "A minimum of 2 players is required to start the game." << endl;
-            return;
-        }
-        
-        notify("Game initiated.");
-
-        gameBoard->display();
+public:
+    static void run() {
+        FastRandom rng(12345);
+        int sizes[] = {100, 1 << 16, 1 << 20, 1 << 23, 1 << 26};
+        double densities[] = {0.1, 0.02, 0.002, 0.0002};
         
-        while(!isGameOver) {
-            SnakeAndLadderPlayer* currentPlayer = turnQueue.front();
-            
-            cout << "\n" << currentPlayer->getName() << "'s turn. Press Enter to roll the dice...";
-            cin.ignore();
-            cin.get();
-            
-            int rollValue = gameDice->roll();
-            cout << "Dice result: " << rollValue << endl;
-            
-            int currentPos = currentPlayer->getPosition();
-            
-            if(gameRules->isValidMove(currentPos, rollValue, gameBoard->getBoardSize())) {
-                int intermediatePos = currentPos + rollValue;
-                int newPos = gameRules->calculateNewPosition(currentPos, rollValue, gameBoard);
-                
-                currentPlayer->setPosition(newPos);
-                
-                // Check if player encountered snake or ladder
-                BoardEntity* entity = gameBoard->getEntity(intermediatePos);
-                if(entity != nullptr) {
-                    bool encounteredSnake = (entity->name() == "SNAKE");
-                    if(encounteredSnake) {
-                        cout << "Encountered snake at " << intermediatePos << ". Moving down to " << newPos << "." << endl;
-                        notify(currentPlayer->getName() + " encountered a snake at " + to_string(intermediatePos) + " and moved down to " + to_string(newPos));
-                    }
-                    else {
-                        cout << "Encountered ladder at " << intermediatePos << ". Moving up to " << newPos << "." << endl;
-                        notify(currentPlayer->getName() + " encountered a ladder at " + to_string(intermediatePos) + " and moved up to " + to_string(newPos));
-                    }
+        cout << "cells\tdensity\tauto\tdense ns\tbitmap ns\teytzinger ns" << endl;
+        for(int cells : sizes) {
+            for(double density : densities) {
+                vector<int> starts;
+                for(int cell = 1; cell < cells; cell++) {
+                    if(rng.next() < (uint64_t)(density * 18446744073709551615.0)) starts.push_back(cell);
+                }
+                vector<int> queries(1 << 20);
+                for(auto& query : queries) {
+                    query = (int)(rng.next() % (uint64_t)cells) + 1;
                 }
                 
-                notify(currentPlayer->getName() + " completed a move. Current position: " + to_string(newPos));
-                displayPlayerPositions();
+                EntityLookup dense, bitmap, eytzinger;
+                dense.build(cells, starts, EntityLookup::DENSE);
+                bitmap.build(cells, starts, EntityLookup::BITMAP_RANK);
+                eytzinger.build(cells, starts, EntityLookup::EYTZINGER);
                 
-                if(gameRules->checkWinCondition(newPos, gameBoard->getBoardSize())) {
-                    cout << "\n" << currentPlayer->getName() << " has won the game." << endl;
-                    currentPlayer->incrementScore();
-
-                    notify(string("Game concluded. Winner: ") + currentPlayer->getName());
-                    isGameOver = true;
-                }
-                else {
-                    // Move player to back of queue
-                    turnQueue.pop_front();
-                    turnQueue.push_back(currentPlayer);
-                }
-            }
-            else {
-                cout << "Exact roll required to reach cell " << gameBoard->getBoardSize() << "." << endl;
-                // Move player to back of queue
-                turnQueue.pop_front();
-                turnQueue.push_back(currentPlayer);
+                const char* modeNames[] = {"auto", "dense", "bitmap", "eytzinger"};
+                cout << cells << "\t" << density << "\t" << modeNames[EntityLookup::chooseMode(cells, starts.size())]
+                     << "\t" << nanosPerLookup(dense, queries) << "\t" << nanosPerLookup(bitmap, queries)
+                     << "\t" << nanosPerLookup(eytzinger, queries) << endl;
             }
         }
     }
-    
-    ~SnakeAndLadderGame() {
-        delete gameRules;
-    }
 };
 
-// Factory Pattern
-class SnakeAndLadderGameFactory {
-public:
-    static SnakeAndLadderGame* createStandardGame() {
-        Board* board = new Board(10);  // Standard 10x10 board
-        BoardSetupStrategy* strategy = new StandardBoardSetupStrategy();
-        board->setupBoard(strategy);
-        delete strategy;
-        
-        Dice* dice = new Dice(6);  // Standard 6-faced dice
-        
-        return new SnakeAndLadderGame(board, dice);
+// Main function for Snake and Ladder
+int main(int argc, char* argv[]) {
+    if(argc > 1 && string(argv[1]) == "--bench-index") {
+        EntityLookupBenchmark::run();
+        return 0;
     }
-    
-    static SnakeAndLadderGame* createRandomGame(int boardSize, RandomBoardSetupStrategy::Difficulty difficulty) {
-        Board* board = new Board(boardSize);
-        BoardSetupStrategy* strategy = new RandomBoardSetupStrategy(difficulty);
-        board->setupBoard(strategy);
-        delete strategy;
-        
-        Dice* dice = new Dice(6);
-        
-        return new SnakeAndLadderGame(board, dice);
+    if(argc > 1 && string(argv[1]) == "--bench-batch-solver") {
+        return BatchSolverBenchmark::run() ? 0 : 1;
     }
-    
-    static SnakeAndLadderGame* createCustomGame(int boardSize, BoardSetupStrategy* strategy) {
-        Board* board = new Board(boardSize);
-        board->setupBoard(strategy);
-        
-        Dice* dice = new Dice(6);
-        
-        return new SnakeAndLadderGame(board, dice);
+    if(argc > 1 && string(argv[1]) == "--self-check") {
+        return AnalyzerSelfCheck::run() ? 0 : 1;
     }
-};
-
-// Main function for Snake and Ladder
-int main() {
+    if(argc > 4 && string(argv[1]) == "--design-board") {
+        // --design-board <side> <mean turns> <output board file> [checkpoint file]
+        DesignTargets targets;
+        targets.meanTurns = atof(argv[3]);
+        targets.entities = atoi(argv[2]) * atoi(argv[2]) / 5;
+        DesignOptions options;
+        if(argc > 5) options.checkpointPath = argv[5];
+        vector<DesignedBoard> designed = BoardDesigner::design(atoi(argv[2]), []() -> SnakeAndLadderRules* {
+            return new StandardSnakeAndLadderRules();
+        }, DiceDistribution::fair(6), targets, options);
+        return (!designed.empty() && BoardDesigner::writeBoardFile(argv[4], designed[0])) ? 0 : 1;
+    }
+    if(argc > 1 && string(argv[1]) == "--calibrate-difficulty") {
+        RandomBoardSetupStrategy::printCalibrationTable();
+        return 0;
+    }
+    if(argc > 3 && string(argv[1]) == "--visit-heatmap") {
+        // --visit-heatmap <side> <board file>
+        Board heatmapBoard(atoi(argv[2]));
+        FileBoardSetupStrategy fileStrategy(argv[3]);
+        heatmapBoard.setupBoard(&fileStrategy);
+        if(!fileStrategy.isLoaded()) {
+            return 1;
+        }
+        StandardSnakeAndLadderRules rules;
+        VisitHeatmap heatmap;
+        if(!VisitAnalyzer::analyze(&heatmapBoard, &rules, DiceDistribution::fair(6), heatmap)) {
+            return 1;
+        }
+        heatmapBoard.display();
+        heatmapBoard.displayHeatmap(heatmap.landings, "Expected landings per game");
+        cout << "\nExpected hits per game:" << endl;
+        for(auto& entity : heatmap.entities) {
+            cout << (entity.isSnake ? "Snake: " : "Ladder: ") << entity.start << " -> " << entity.end
+                 << "  " << entity.hitsPerGame << endl;
+        }
+        return 0;
+    }
+    if(argc > 5 && string(argv[1]) == "--analyze-huge-board") {
+        // --analyze-huge-board <side> <difficulty 1-3> <output file> <scratch directory>
+        int64_t side = atoll(argv[2]);
+        // The output holds cells + 1 doubles, so that many bytes must fit in size_t
+        if(side <= 1 || side > 3037000499LL || (uint64_t)(side * side) + 1 > SIZE_MAX / sizeof(double)) {
+            cout << "Board side " << argv[2] << " is out of range: it must be at least 2, and side * side + 1 doubles must fit in size_t." << endl;
+            return 1;
+        }
+        HugeBoard hugeBoard(side);
+        int level = min(3, max(1, atoi(argv[3])));
+        RandomBoardSetupStrategy::Difficulty difficulty = level == 1 ? RandomBoardSetupStrategy::EASY
+            : level == 2 ? RandomBoardSetupStrategy::MEDIUM : RandomBoardSetupStrategy::HARD;
+        double start = 0.0;
+        if(!HugeBoardGenerator::generate(hugeBoard, difficulty, 1) ||
+           !ParallelHugeBoardAnalyzer::expectedTurnsToFile(hugeBoard, argv[4], argv[5], start)) {
+            return 1;
+        }
+        cout << "Expected turns from the start: " << start << endl;
+        return 0;
+    }
+    
     cout << "=== SNAKES & LADDERS ===" << endl;
     
     SnakeAndLadderGame* game = nullptr;
@@ -628,6 +6264,7 @@ int main() {
         cout << "Select custom setup mode:" << endl;
         cout << "1. Specify counts only (random placement)" << endl;
         cout << "2. Specify exact positions for each entity" << endl;
+        cout << "3. Load entities from a board file" << endl;
         
         int customChoice;
         cin >> customChoice;
@@ -644,6 +6281,15 @@ int main() {
             delete strategy;
             
         } 
+        else if(customChoice == 3) {
+            string filePath;
+            cout << "Enter board file path: ";
+            cin >> filePath;
+            
+            BoardSetupStrategy* strategy = new FileBoardSetupStrategy(filePath);
+            game = SnakeAndLadderGameFactory::createCustomGame(boardSize, strategy);
+            delete strategy;
+        }
         else {
             int numSnakes, numLadders;
             cout << "Enter number of snakes: ";